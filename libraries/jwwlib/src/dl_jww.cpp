@@ -655,6 +655,32 @@ void DL_Jww::CreateBlock(DL_CreationInterface* /*creationInterface*/, CDataBlock
 #endif
 }
 
+namespace {
+/**
+ * Creates the entities of the records while the file is read, in file
+ * order, without keeping all records in memory first.
+ */
+class	JwwCreator	:	public	JWWDataHandler
+{
+public:
+	JwwCreator(DL_Jww& jww, DL_CreationInterface* creationInterface):
+		jww(jww)
+	  , creationInterface(creationInterface)
+	{}
+	void AddSen(CDataSen& D) override {jww.CreateSen(creationInterface, D);}
+	void AddEnko(CDataEnko& D) override {jww.CreateEnko(creationInterface, D);}
+	void AddTen(CDataTen& D) override {jww.CreateTen(creationInterface, D);}
+	void AddMoji(CDataMoji& D) override {jww.CreateMoji(creationInterface, D);}
+	void AddSolid(CDataSolid& D) override {jww.CreateSolid(creationInterface, D);}
+	void AddSunpou(CDataSunpou& D) override {jww.CreateSunpou(creationInterface, D);}
+	void AddBlock(CDataBlock& D) override {jww.CreateBlock(creationInterface, D);}
+
+private:
+	DL_Jww& jww;
+	DL_CreationInterface* creationInterface;
+};
+}
+
 /**
  * @brief Reads the given file and calls the appropriate functions in
  * the given creation interface for every entity found in the file.
@@ -670,36 +696,13 @@ void DL_Jww::CreateBlock(DL_CreationInterface* /*creationInterface*/, CDataBlock
 bool DL_Jww::in(const string& file, DL_CreationInterface* creationInterface) {
 	//JWWファイル読み取り
 	string ofile("");
-	JWWDocument* jwdoc = new JWWDocument((std::string&)file, ofile);
-	if(!jwdoc->Read())
-		return false;
+	JWWDocument jwdoc((std::string&)file, ofile);
 	//DXF変数設定
 	creationInterface->setVariableString("$DWGCODEPAGE", "SJIS", 7);
 	creationInterface->setVariableString("$TEXTSTYLE", "japanese", 7);
-	//線分データ
-	for( unsigned int i = 0; i < jwdoc->vSen.size(); i++ )
-		CreateSen(creationInterface, jwdoc->vSen[i]);
-	//円弧データ
-	for( unsigned int i = 0; i < jwdoc->vEnko.size(); i++ )
-		CreateEnko(creationInterface, jwdoc->vEnko[i]);
-	//点データ
-	for( unsigned int i = 0; i < jwdoc->vTen.size(); i++ )
-		CreateTen(creationInterface, jwdoc->vTen[i]);
-	//文字データ
-	for( unsigned int i = 0; i < jwdoc->vMoji.size(); i++ )
-		CreateMoji(creationInterface, jwdoc->vMoji[i]);
-	//寸法
-    for(unsigned int i=0 ; i < jwdoc->vSunpou.size(); i++ )
-		CreateSunpou(creationInterface, jwdoc->vSunpou[i]);
-	//ソリッド
-    for(unsigned int i=0 ; i < jwdoc->vSolid.size(); i++ )
-		CreateSolid(creationInterface, jwdoc->vSolid[i]);
-	//部品
-    for(unsigned int i=0 ; i < jwdoc->vBlock.size(); i++)
-		CreateBlock(creationInterface, jwdoc->vBlock[i]);
-	delete jwdoc;
-
-	return true;
+	//図形データはファイルの順に作成する
+	JwwCreator creator(*this, creationInterface);
+	return jwdoc.Read(&creator);
 }
 
 /**
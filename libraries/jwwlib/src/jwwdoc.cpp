@@ -1,5 +1,4 @@
 #include "jwwdoc.h"
-#define	LINEBUF_SIZE	1024
 
 void JWWDocument::WriteString(string s){
     int len = s.length();
@@ -17,43 +16,12 @@ void JWWDocument::WriteString(string s){
 
 string JWWDocument::ReadData(int n)
 {
-    //avoid buffer overflow
-    if(n>LINEBUF_SIZE){
-        //should not happen
-        std::cerr<<"JWWDocument::ReadData("<<n<<"): requested data length is larger than "<<LINEBUF_SIZE<<std::endl;
-    }
-    string	Result;
-    Result.resize(n);
-    if( n > 0 )
-        ifs->read(&(Result[0]), n);
-//    Result += '\0'; // may not be necessary, to make sure the string ends with '\0';
-    return Result;
-
-//	char cbuf[LINEBUF_SIZE];
-//	cbuf[0] = (char)NULL;
-//	if( n > 0 )
-//		ifs->read(cbuf, n);
-//	cbuf[n] = (char)NULL;
-//	string	Result(cbuf, n);
-//	return	Result;
+    return ifs->ReadData(n > 0 ? n : 0);
 }
 
 string JWWDocument::ReadString()
 {
-    jwBYTE bt;
-    jwWORD wd;
-    string	Result("");
-    *ifs >> bt;
-    if( bt == 0 )
-        return Result;
-    else if( bt != 0xFF )
-        Result = ReadData(bt);
-    else
-    {
-        *ifs >> wd;
-        Result = ReadData(wd);
-    }
-    return	Result;
+    return ifs->ReadString();
 }
 
 //ヘッダー部読みだし(JWW形式とバージョンチェック)
@@ -942,9 +910,9 @@ jwBOOL JWWDocument::WriteHeader()
 }
 
 //データファイル読み込み
-jwBOOL JWWDocument::Read()
+jwBOOL JWWDocument::Read(JWWDataHandler* handler)
 {
-    if(!ifs)
+    if(!ifs || !ifs->is_open())
         return false;
 
     jwDWORD dw;
@@ -1064,7 +1032,10 @@ cout << DSen;
                 ListCount++;
             } else
             {
-                vSen.push_back(DSen);
+                if( handler )
+                    handler->AddSen(DSen);
+                else
+                    vSen.push_back(DSen);
                 SenCount++;
             }
         }
@@ -1081,7 +1052,10 @@ cout << DEnko;
             }
             else
             {
-                vEnko.push_back(DEnko);
+                if( handler )
+                    handler->AddEnko(DEnko);
+                else
+                    vEnko.push_back(DEnko);
                 EnkoCount++;
             }
         }
@@ -1097,7 +1071,10 @@ cout << DTen;
                 ListCount++;
             } else
             {
-                vTen.push_back(DTen);
+                if( handler )
+                    handler->AddTen(DTen);
+                else
+                    vTen.push_back(DTen);
                 TenCount++;
             }
         }
@@ -1113,7 +1090,10 @@ cout << DMoji;
                 ListCount++;
             } else
             {
-                vMoji.push_back(DMoji);
+                if( handler )
+                    handler->AddMoji(DMoji);
+                else
+                    vMoji.push_back(DMoji);
                 MojiCount++;
             }
         }
@@ -1129,7 +1109,10 @@ cout << DSolid;
                 ListCount++;
             } else
             {
-                vSolid.push_back(DSolid);
+                if( handler )
+                    handler->AddSolid(DSolid);
+                else
+                    vSolid.push_back(DSolid);
                 SolidCount++;
             }
         }
@@ -1145,7 +1128,10 @@ cout << DBlock;
                 ListCount++;
             } else
             {
-                vBlock.push_back(DBlock);
+                if( handler )
+                    handler->AddBlock(DBlock);
+                else
+                    vBlock.push_back(DBlock);
                 BlockCount++;
             }
         }
@@ -1161,7 +1147,10 @@ cout << DSunpou;
                 ListCount++;
             } else
             {
-                vSunpou.push_back(DSunpou);
+                if( handler )
+                    handler->AddSunpou(DSunpou);
+                else
+                    vSunpou.push_back(DSunpou);
                 SunpouCount++;
             }
         }
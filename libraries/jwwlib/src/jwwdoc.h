@@ -2,6 +2,7 @@
 #define	JWWDOC_H
 
 #include "jwtype.h"
+#include "jwwreader.h"
 
 typedef struct	_DPoint{
 	jwDOUBLE	x;
@@ -221,7 +222,7 @@ public:
         ofstr << (jwWORD)m_nGLayer;     //レイヤグループ番号
         ofstr << (jwWORD)m_sFlg;        //属性フラグ
 	}
-	void Serialize(std::ifstream& ifstr) {
+	void Serialize(JWWReader& ifstr) {
        ifstr >> /*(jwDWORD)*/m_lGroup;      //曲線属性番号
        ifstr >> /*(jwBYTE)*/m_nPenStyle;   //線種番号
        ifstr >> /*(jwWORD)*/m_nPenColor;   //線色番号
@@ -297,7 +298,7 @@ public:
 				<< (double)m_end.x << (double)m_end.y;
 	}
 
-	void Serialize(std::ifstream& ifstr){
+	void Serialize(JWWReader& ifstr){
 	    CData::Serialize(ifstr);
 		ifstr	>> m_start.x >> m_start.y
 				>> m_end.x >> m_end.y;
@@ -344,7 +345,7 @@ public:
 				<< (jwDWORD )m_bZenEnFlg;
 	}
 
-	void Serialize(std::ifstream& ifstr){
+	void Serialize(JWWReader& ifstr){
 	    CData::Serialize(ifstr);
 		ifstr >> /*(double)*/m_start.x >> /*(double)*/m_start.y
 			>> /*(double)*/m_dHankei
@@ -409,7 +410,7 @@ public:
             }
 	}
 
-	void Serialize(std::ifstream& ifstr){
+	void Serialize(JWWReader& ifstr){
 	    CData::Serialize(ifstr);
         ifstr >> m_start.x >> m_start.y;
         ifstr >> m_bKariten;
@@ -499,7 +500,7 @@ public:
         m_nMojiShu = (m_nMojiShu % 10000);
 	}
 
-	void Serialize(std::ifstream& ifstr) {
+	void Serialize(JWWReader& ifstr) {
         CData::Serialize(ifstr);
         ifstr >> m_start.x >> m_start.y 
            >> m_end.x >> m_end.y
@@ -507,45 +508,8 @@ public:
            >> m_dSizeX >> m_dSizeY
            >> m_dKankaku
            >> m_degKakudo;
-		jwBYTE bt;
-		jwWORD wd;
-         char buf[512];
-			ifstr >> bt;
-			if( bt != 0xFF ){
-				ifstr.read(buf,bt);
-				buf[bt] = '\0';
-				m_strFontName = buf;
-#ifdef	DATA_DUMP
-cout << "MojiData1:" << m_strFontName << endl;
-#endif
-			}else
-			{
-				ifstr >> wd;
-				ifstr.read(buf,wd);
-				buf[wd] = '\0';
-				m_strFontName = buf;
-#ifdef	DATA_DUMP
-cout << "MojiData2:" << m_strFontName << endl;
-#endif
-			}
-			ifstr >> bt;
-			if( bt != 0xFF ){
-				ifstr.read(buf,bt);
-				buf[bt] = '\0';
-				m_string = buf;
-#ifdef	DATA_DUMP
-cout << "MojiData3:"  << m_string << endl;
-#endif
-			}else
-			{
-				ifstr >> wd;
-				ifstr.read(buf,wd);
-				buf[wd] = '\0';
-				m_string = buf;
-#ifdef	DATA_DUMP
-cout << "MojiData4:"  << m_string << endl;
-#endif
-			}
+		m_strFontName = ifstr.ReadString();
+		m_string = ifstr.ReadString();
 /*        m_nPenWidth = 1;            //文字枠幅を1
         if( m_sMojiFlg & 0x0001 ){ m_nMojiShu += 10000; }  //斜体文字
         if( m_sMojiFlg & 0x0010 ){ m_nMojiShu += 20000; }  //ボールド
@@ -596,7 +560,7 @@ public:
             m_TenHo2 .Serialize(ofstr);
         }
 	}
-	void Serialize(std::ifstream& ifstr) {
+	void Serialize(JWWReader& ifstr) {
 	    CData::Serialize(ifstr);
         m_Sen .Serialize(ifstr);
         m_Moji.Serialize(ifstr);
@@ -665,7 +629,7 @@ public:
             }
         }
 
-	void Serialize(std::ifstream& ifstr) {
+	void Serialize(JWWReader& ifstr) {
 	    CData::Serialize(ifstr);
         ifstr >> m_start.x >> m_start.y 
            >> m_end.x >> m_end.y
@@ -709,7 +673,7 @@ public:
            <</*(jwDWORD)m_pDataList->*/m_n_Number;//ポインタでなく通し番号を保存する
 	}
 
-	void Serialize(std::ifstream& ifstr){
+	void Serialize(JWWReader& ifstr){
 	    CData::Serialize(ifstr);
         ifstr >> m_DPKijunTen.x >> m_DPKijunTen.y
            >> m_dBairitsuX
@@ -770,7 +734,7 @@ public:
 		}
 	    //SKIP m_DataList.Serialize(ofstr);
 	}
-	void Serialize(std::ifstream& ifstr) {
+	void Serialize(JWWReader& ifstr) {
 	    CData::Serialize(ifstr);
         ifstr >> m_nNumber
            >> m_bReffered
@@ -779,27 +743,7 @@ public:
 		//"@@SfigorgFlag@@"に続けて、複合図形種別フラグを付加
 		//1:部分図(数学座標系)、2: 部分図(測地座標系)、
 		//3:作図グループ、4:作図部品
-		jwBYTE bt;
-		jwWORD wd;
-		char buf[512];
-		ifstr >> bt;
-		if( bt != 0xFF ){
-			ifstr.read(buf,bt);
-			buf[bt] = '\0';
-			m_strName = buf;
-#ifdef	DATA_DUMP
-cout << "MojiData1:"  << m_strName << endl;
-#endif
-		}else
-		{
-			ifstr >> wd;
-			ifstr.read(buf,wd);
-			buf[wd] = '\0';
-			m_strName = buf;
-#ifdef	DATA_DUMP
-cout << "MojiData1:"  << m_strName << endl;
-#endif
-		}
+		m_strName = ifstr.ReadString();
 	    //SKIP m_DataList.Serialize(ifstr);
 	}
 };
@@ -888,6 +832,25 @@ public:
 	void AddItem(int No,string& str);
 };
 
+//図形データの受け取り
+/**
+ * Receives the drawing records of JWWDocument::Read() in file order, as
+ * they are decoded. The records are reused for the next one, copy what
+ * is kept. Block definitions still go to JWWDocument::pBlockList.
+ */
+class	JWWDataHandler
+{
+public:
+	virtual ~JWWDataHandler() = default;
+	virtual void AddSen(CDataSen& D) = 0;
+	virtual void AddEnko(CDataEnko& D) = 0;
+	virtual void AddTen(CDataTen& D) = 0;
+	virtual void AddMoji(CDataMoji& D) = 0;
+	virtual void AddSolid(CDataSolid& D) = 0;
+	virtual void AddSunpou(CDataSunpou& D) = 0;
+	virtual void AddBlock(CDataBlock& D) = 0;
+};
+
 //JWWファイル入出力クラス
 class	JWWDocument
 {
@@ -898,7 +861,7 @@ public:
 	JWWDocument(string& iFName, string& oFName){
 		InputFName = iFName;
 		if(iFName.length()>0)
-			ifs = new ifstream(iFName.c_str(),ios::binary);
+			ifs = new JWWReader(iFName);
 		else
 			ifs = NULL;
 		OutputFName = oFName;
@@ -912,10 +875,7 @@ public:
 	~JWWDocument(){
 		delete pList;
 		delete pBlockList;
-		if(ifs){
-			ifs->close();
-			delete ifs;
-		}
+		delete ifs;
 		if(ofs){
 			ofs->close();
 			delete ofs;
@@ -923,7 +883,7 @@ public:
 	}
 // 各図形のレコードの実体
 	JWWHead	Header;
-	ifstream*	ifs;
+	JWWReader*	ifs;
 	ofstream*	ofs;
 	jwWORD objCode;
 	jwDWORD Mpoint;
@@ -967,7 +927,8 @@ public:
 	string ReadString();
 	jwBOOL ReadHeader();
 	jwBOOL WriteHeader();
-	jwBOOL Read();
+	//handler を指定すると図形データは vSen などに格納しない
+	jwBOOL Read(JWWDataHandler* handler = NULL);
 	jwBOOL Save();
 	jwBOOL SaveBich16(jwDWORD id);
 	jwBOOL SaveSen(CDataSen const& DSen);
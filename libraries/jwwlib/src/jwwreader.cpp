@@ -0,0 +1,68 @@
+#include "jwwreader.h"
+
+JWWReader::JWWReader(const string& fileName):
+	file(fileName.c_str(), ios::binary)
+{
+	buffer.resize(BLOCK_SIZE);
+}
+
+//全て読み込んだか
+bool JWWReader::eof()
+{
+	return pos == end && !fill(1);
+}
+
+void JWWReader::read(char* data, size_t n)
+{
+	while( n > 0 ){
+		if( pos == end && !fill(1) ){
+			failed = true;
+			std::memset(data, 0, n);
+			return;
+		}
+		size_t count = std::min(n, end - pos);
+		std::memcpy(data, buffer.data() + pos, count);
+		pos += count;
+		data += count;
+		n -= count;
+	}
+}
+
+string JWWReader::ReadData(size_t n)
+{
+	string	Result(n, '\0');
+	if( n > 0 )
+		read(&(Result[0]), n);
+	return Result;
+}
+
+string JWWReader::ReadString()
+{
+	jwBYTE bt;
+	jwWORD wd;
+	*this >> bt;
+	if( bt == 0 )
+		return string();
+	if( bt != 0xFF )
+		return ReadData(bt);
+	*this >> wd;
+	return ReadData(wd);
+}
+
+//バッファにn バイト以上を用意する
+bool JWWReader::fill(size_t n)
+{
+	// the unread rest moves to the front, the next block follows it
+	size_t rest = end - pos;
+	if( rest > 0 && pos > 0 )
+		std::memmove(buffer.data(), buffer.data() + pos, rest);
+	pos = 0;
+	end = rest;
+	if( buffer.size() < n )
+		buffer.resize(n);
+	while( end < n && file ){
+		file.read(buffer.data() + end, buffer.size() - end);
+		end += static_cast<size_t>(file.gcount());
+	}
+	return end >= n;
+}
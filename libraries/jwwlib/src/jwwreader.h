@@ -0,0 +1,92 @@
+#ifndef	JWWREADER_H
+#define	JWWREADER_H
+
+#include <cstddef>
+#include <cstring>
+#include "jwtype.h"
+
+//JWWファイルのバッファ付き読み込み
+/**
+ * Block buffered reader for JWW files.
+ *
+ * The file is read in blocks of BLOCK_SIZE bytes and the values are
+ * decoded from the buffer, not with one stream call per field. JWW files
+ * are little endian, values are assembled byte by byte, so big endian
+ * hosts read them correctly too.
+ *
+ * Reading past the end of the file yields zeros and makes good() false.
+ */
+class	JWWReader
+{
+public:
+	static const size_t BLOCK_SIZE = 64*1024;
+
+	explicit JWWReader(const string& fileName);
+
+	bool is_open() const {return file.is_open();}
+	/** false after reading past the end of the file */
+	bool good() const {return !failed;}
+	/** true if all bytes of the file were read */
+	bool eof();
+
+	void read(char* data, size_t n);
+	/** @return the next n bytes */
+	string ReadData(size_t n);
+	/** @return a string stored as a byte length, or 0xFF and a word length, and the bytes */
+	string ReadString();
+
+	/** @return the next n bytes, zeros past the end of the file */
+	const unsigned char* take(size_t n){
+		if( end - pos < n && !fill(n) ){
+			failed = true;
+			pos = end;
+			return zeros;
+		}
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer.data()) + pos;
+		pos += n;
+		return p;
+	}
+
+private:
+	bool fill(size_t n);
+
+	ifstream file;
+	vector<char> buffer;
+	size_t pos = 0;
+	size_t end = 0;
+	bool failed = false;
+	unsigned char zeros[8] = {};
+};
+
+inline JWWReader& operator>> (JWWReader& in, jwBYTE& input)
+{
+	input = *in.take(1);
+	return in;
+}
+
+inline JWWReader& operator>> (JWWReader& in, jwWORD& input)
+{
+	const unsigned char* p = in.take(2);
+	input = jwWORD(p[0] | p[1] << 8);
+	return in;
+}
+
+inline JWWReader& operator>> (JWWReader& in, jwDWORD& input)
+{
+	const unsigned char* p = in.take(4);
+	input = jwDWORD(p[0]) | jwDWORD(p[1]) << 8 | jwDWORD(p[2]) << 16 | jwDWORD(p[3]) << 24;
+	return in;
+}
+
+inline JWWReader& operator>> (JWWReader& in, jwDOUBLE& input)
+{
+	const unsigned char* p = in.take(8);
+	unsigned long long bits = 0;
+	for( int i = 7; i >= 0; i-- )
+		bits = bits << 8 | p[i];
+	static_assert(sizeof(bits) == sizeof(input), "JWW doubles are 8 bytes");
+	std::memcpy(&input, &bits, sizeof(input));
+	return in;
+}
+
+#endif //JWWREADER_H
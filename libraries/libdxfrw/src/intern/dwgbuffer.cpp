@@ -11,6 +11,7 @@
 ******************************************************************************/
 
 
+#include <cstring>
 #include "dwgbuffer.h"
 #include "../libdwgr.h"
 #include "drw_textcodec.h"
@@ -102,136 +103,72 @@ static unsigned int crc32Table[256] ={
 0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
 
-union typeCast  {
-    char buf[8];
-    duint16 i16;
-    duint32 i32;
-    duint64 i64;
-    ddouble64 d64;
-};
-
-bool dwgFileStream::setPos(duint64 p){
-    if (p >= sz)
-        return false;
-
-    stream->seekg(p);
-    return stream->good();
-}
-
-bool dwgFileStream::read(duint8* s, duint64 n){
-    stream->read (reinterpret_cast<char*>(s),n);
-    return stream->good();
-}
-
-bool dwgCharStream::setPos(duint64 p){
-    if (p > size()) {
-        isOk = false;
-        return false;
-    }
-
-    pos = p;
-    return true;
-}
-
-bool dwgCharStream::read(duint8* s, duint64 n){
-    if ( n > (sz - pos) ) {
-        isOk = false;
-        return false;
-    }
-    for (duint64 i=0; i<n; i++){
-        s[i]= stream[pos++];
-    }
-    return true;
-}
-
-dwgBuffer::dwgBuffer(duint8 *buf, duint64 size, DRW_TextCodec *dc)
+dwgBuffer::dwgBuffer(const duint8 *buf, duint64 size, DRW_TextCodec *dc)
     :decoder{dc}
-    ,filestr{new dwgCharStream(buf, size)}
-    ,maxSize{size}
+    ,data{buf}
+    ,dataSize{size}
 {}
 
 dwgBuffer::dwgBuffer(std::ifstream *stream, DRW_TextCodec *dc)
     :decoder{dc}
-    ,filestr{new dwgFileStream(stream)}
-    ,maxSize{filestr->size()}
-{}
-
-dwgBuffer::dwgBuffer( const dwgBuffer& org )
-    :decoder{org.decoder}
-    ,filestr{org.filestr->clone()}
-    ,maxSize{filestr->size()}
-    ,currByte{org.currByte}
-    ,bitPos{org.bitPos}
-{}
-
-dwgBuffer& dwgBuffer::operator=( const dwgBuffer& org ){
-    filestr.reset( org.filestr->clone());
-    decoder = org.decoder;
-    maxSize = filestr->size();
-    currByte = org.currByte;
-    bitPos = org.bitPos;
-    return *this;
+{
+    stream->seekg(0, std::ios::end);
+    std::streamoff sz = stream->tellg();
+    stream->seekg(0, std::ios_base::beg);
+    auto contents = std::make_shared<std::vector<duint8>>(sz > 0 ? sz : 0);
+    stream->read(reinterpret_cast<char*>(contents->data()), contents->size());
+    good = stream->good();
+    storage = contents;
+    data = contents->data();
+    dataSize = contents->size();
+}
+
+dwgBuffer dwgBuffer::getSubBuffer(duint64 size, DRW_TextCodec *dc){
+    duint64 pos = getPosition();
+    if ((bitOffset & 7) != 0 || size > dataSize - pos) {
+        good = false;
+        return dwgBuffer(nullptr, 0, dc);
+    }
+    dwgBuffer ret(*this);
+    ret.decoder = dc;
+    ret.data = data + pos;
+    ret.dataSize = size;
+    ret.bitOffset = 0;
+    bitOffset += size * 8;
+    return ret;
 }
 
-/**Gets the current byte position in buffer **/
-duint64 dwgBuffer::getPosition() const{
-     if (bitPos != 0)
-         return filestr->getPos() -1;
-     return filestr->getPos();
- }
-
 /**Sets the buffer position in pos byte, reset the bit position **/
 bool dwgBuffer::setPosition(duint64 pos){
-    bitPos = 0;
-/*    if (pos>=maxSize)
-        return false;*/
-    return filestr->setPos(pos);
-//    return true;
+    if (pos > dataSize) {
+        good = false;
+        return false;
+    }
+    bitOffset = pos * 8;
+    return true;
 }
 
-//RLZ: Fails if ... ???
 void dwgBuffer::setBitPos(duint8 pos){
     if (pos>7)
         return;
-    if (pos != 0 && bitPos == 0){
-        duint8 buffer;
-        filestr->read (&buffer,1);
-        currByte = buffer;
-    }
-    if (pos == 0 && bitPos != 0){//reset current byte
-        filestr->setPos(filestr->getPos()-1);
-    }
-    bitPos = pos;
+    bitOffset = (bitOffset & ~static_cast<duint64>(7)) + pos;
 }
 
 bool dwgBuffer::moveBitPos(dint32 size){
     if (size == 0) return true;
 
-    dint32 b= size + bitPos;
-    filestr->setPos(getPosition() + (b >> 3) );
-    bitPos = b & 7;
-
-    if (bitPos != 0){
-        filestr->read (&currByte,1);
+    if ((size < 0 && static_cast<duint64>(-static_cast<dint64>(size)) > bitOffset)
+            || bitOffset + size > dataSize * 8) {
+        good = false;
+        return false;
     }
-    return filestr->good();
+    bitOffset += size;
+    return good;
 }
 
 /**Reads one Bit returns a char with value 0/1 (B) **/
 duint8 dwgBuffer::getBit(){
-    duint8 buffer;
-    duint8 ret = 0;
-    if (bitPos == 0){
-        filestr->read (&buffer,1);
-        currByte = buffer;
-    }
-
-    ret = (currByte >> (7 - bitPos) & 1);
-    bitPos +=1;
-    if (bitPos == 8)
-        bitPos = 0;
-
-    return ret;
+    return getBits(1);
 }
 
 /**Reads one Bit returns a bool value 0==false 1==true (B) **/
@@ -241,58 +178,14 @@ bool dwgBuffer::getBoolBit(){
 
 /**Reads two Bits returns a char (BB) **/
 duint8 dwgBuffer::get2Bits(){
-    duint8 buffer;
-    duint8 ret = 0;
-    if (bitPos == 0){
-        filestr->read (&buffer,1);
-        currByte = buffer;
-    }
-
-    bitPos +=2;
-    if (bitPos < 9)
-        ret = currByte >>(8 - bitPos);
-    else {//read one bit per byte
-        ret = currByte << 1;
-        filestr->read (&buffer,1);
-        currByte = buffer;
-        bitPos = 1;
-        ret = ret | currByte >> 7;
-    }
-    if (bitPos == 8)
-        bitPos = 0;
-    ret = ret & 3;
-    return ret;
+    return getBits(2);
 }
 
 /**Reads thee Bits returns a char (3B) **/
-//RLZ: todo verify this
 duint8 dwgBuffer::get3Bits(){
-    duint8 buffer;
-    duint8 ret = 0;
-    if (bitPos == 0){
-        filestr->read (&buffer,1);
-        currByte = buffer;
-    }
-
-    bitPos +=3;
-    if (bitPos < 9)
-        ret = currByte >>(8 - bitPos);
-    else {//read one bit per byte
-        ret = currByte << 1;
-        filestr->read (&buffer,1);
-        currByte = buffer;
-        bitPos = 1;
-        ret = ret | currByte >> 7;
-    }
-    if (bitPos == 8)
-        bitPos = 0;
-    ret = ret & 7;
-    return ret;
+    return getBits(3);
 }
 
-/**Reads tree Bits returns a char (3B) for R24 **/
-//to be written
-
 /**Reads compressed Short (max. 16 + 2 bits) little-endian order, returns a UNsigned 16 bits (BS) **/
 duint16 dwgBuffer::getBitShort(){
     duint8 b = get2Bits();
@@ -319,7 +212,6 @@ dint16 dwgBuffer::getSBitShort(){
 }
 
 /**Reads compressed 32 bits Int (max. 32 + 2 bits) little-endian order, returns a signed 32 bits (BL) **/
-//to be written
 dint32 dwgBuffer::getBitLong(){
     dint8 b = get2Bits();
     if (b == 0)
@@ -346,17 +238,8 @@ double dwgBuffer::getBitDouble(){
     dint8 b = get2Bits();
     if (b == 1)
         return 1.0;
-    else if (b == 0){
-        duint8 buffer[8];
-        if (bitPos != 0) {
-            for (int i = 0; i < 8; i++)
-                buffer[i] = getRawChar8();
-        } else {
-        filestr->read (buffer,8);
-        }
-        double* ret = reinterpret_cast<double*>( buffer );
-        return *ret;
-    }
+    else if (b == 0)
+        return getRawDouble();
     //    if (b == 2)
     return 0.0;
 }
@@ -372,52 +255,22 @@ DRW_Coord dwgBuffer::get3BitDouble(){
 
 /**Reads raw char 8 bits returns a unsigned char (RC) **/
 duint8 dwgBuffer::getRawChar8(){
-    duint8 ret=0;
-    duint8 buffer=0;
-    filestr->read (&buffer,1);
-    if (bitPos == 0)
-        return buffer;
-    else {
-        ret = currByte << bitPos;
-        currByte = buffer;
-        ret = ret | (currByte >>(8 - bitPos));
-    }
-    return ret;
+    return getBits(8);
 }
 
 /**Reads raw short 16 bits little-endian order, returns a unsigned short (RS) **/
 duint16 dwgBuffer::getRawShort16(){
-    duint8 buffer[2]={0,0};
-    duint16 ret=0;
-
-    filestr->read (buffer,2);
-    if (bitPos == 0) {
-        /* no offset directly swap bytes for little-endian */
-        ret = (buffer[1] << 8) | (buffer[0] & 0x00FF);
-    } else {
-        ret = (buffer[0] << 8) | (buffer[1] & 0x00FF);
-        /* apply offset */
-        ret = ret >> (8 - bitPos);
-        ret = ret | (currByte << (8 + bitPos));
-        currByte = buffer[1];
-        /* swap bytes for little-endian */
-        ret = (ret << 8) | (ret >> 8);
-    }
-    return ret;
+    duint16 ret = getBits(16);
+    /* swap bytes for little-endian */
+    return (ret << 8) | (ret >> 8);
 }
 
 /**Reads raw double IEEE standard 64 bits returns a double (RD) **/
 double dwgBuffer::getRawDouble(){
-    duint8 buffer[8];
-    memset(buffer,0,sizeof(buffer));
-    if (bitPos == 0)
-        filestr->read (buffer,8);
-    else {
-        for (int i = 0; i < 8; i++)
-            buffer[i] = getRawChar8();
-    }
-    double* nOffset = reinterpret_cast<double*>( buffer );
-    return *nOffset;
+    duint64 bits = getRawLong64();
+    double ret;
+    memcpy(&ret, &bits, sizeof(ret));
+    return ret;
 }
 
 /**Reads 2 raw double IEEE standard 64 bits returns a DRW_Coord of floating point double 64 bits (2RD) **/
@@ -431,11 +284,8 @@ DRW_Coord dwgBuffer::get2RawDouble(){
 
 /**Reads raw int 32 bits little-endian order, returns a unsigned int (RL) **/
 duint32 dwgBuffer::getRawLong32(){
-    duint16 tmp1 = getRawShort16();
-    duint16 tmp2 = getRawShort16();
-    duint32 ret = (tmp2 << 16) | (tmp1 & 0x0000FFFF);
-
-    return ret;
+    duint32 v = getBits(32);
+    return (v >> 24) | ((v >> 8) & 0x0000FF00) | ((v << 8) & 0x00FF0000) | (v << 24);
 }
 
 /**Reads raw int 64 bits little-endian order, returns a unsigned long long (RLL) **/
@@ -449,19 +299,15 @@ duint64 dwgBuffer::getRawLong64(){
 
 /**Reads modular unsigner int, char based, compressed form, little-endian order, returns a unsigned int (U-MC) **/
 duint32 dwgBuffer::getUModularChar(){
-    std::vector<duint8> buffer;
     duint32 result =0;
+    int offset = 0;
     for (int i=0; i<4;i++){
         duint8 b= getRawChar8();
-        buffer.push_back(b & 0x7F);
+        result += static_cast<duint32>(b & 0x7F) << offset;
+        offset +=7;
         if (! (b & 0x80))
             break;
     }
-    int offset = 0;
-    for (unsigned int i=0; i<buffer.size();i++){
-        result += buffer[i] << offset;
-        offset +=7;
-    }
 //RLZ: WARNING!!! needed to verify on read handles
     //result = result & 0x7F;
     return result;
@@ -470,25 +316,21 @@ duint32 dwgBuffer::getUModularChar(){
 /**Reads modular int, char based, compressed form, little-endian order, returns a signed int (MC) **/
 dint32 dwgBuffer::getModularChar(){
     bool negative = false;
-    std::vector<dint8> buffer;
     dint32 result =0;
+    int offset = 0;
     for (int i=0; i<4;i++){
         duint8 b= getRawChar8();
-        buffer.push_back(b & 0x7F);
-        if (! (b & 0x80))
-            break;
-    }
-    dint8 b= buffer.back();
-    if (b & 0x40) {
-        negative = true;
-        buffer.pop_back();
-        buffer.push_back(b & 0x3F);
-    }
-
-    int offset = 0;
-    for (unsigned int i=0; i<buffer.size();i++){
-        result += buffer[i] << offset;
+        bool last = !(b & 0x80) || i == 3;
+        dint32 value = b & 0x7F;
+        //sign bit in the last byte
+        if (last && (value & 0x40)) {
+            negative = true;
+            value &= 0x3F;
+        }
+        result += value << offset;
         offset +=7;
+        if (last)
+            break;
     }
     if (negative)
         result = -result;
@@ -497,31 +339,16 @@ dint32 dwgBuffer::getModularChar(){
 
 /**Reads modular int, short based, compressed form, little-endian order, returns a unsigned int (MC) **/
 dint32 dwgBuffer::getModularShort(){
-//    bool negative = false;
-    std::vector<dint16> buffer;
     dint32 result =0;
+    int offset = 0;
     for (int i=0; i<2;i++){
         duint16 b= getRawShort16();
-        buffer.push_back(b & 0x7FFF);
+        result += (b & 0x7FFF) << offset;
+        offset +=15;
         if (! (b & 0x8000))
             break;
     }
-
     //only positive ?
-/*    dint8 b= buffer.back();
-    if (! (b & 0x40)) {
-        negative = true;
-        buffer.pop_back();
-        buffer.push_back(b & 0x3F);
-    }*/
-
-    int offset = 0;
-    for (unsigned int i=0; i<buffer.size();i++){
-        result += buffer[i] << offset;
-        offset +=15;
-    }
-/*    if (negative)
-        result = -result;*/
     return result;
 }
 
@@ -693,12 +520,7 @@ double dwgBuffer::getDefaultDouble(double d){
     else if (b == 1){
         duint8 buffer[4];
         char *tmp=nullptr;
-        if (bitPos != 0) {
-            for (int i = 0; i < 4; i++)
-                buffer[i] = getRawChar8();
-        } else {
-        filestr->read (buffer,4);
-        }
+        getBytes(buffer, 4);
         tmp = reinterpret_cast<char*>(&d);
         for (int i = 0; i < 4; i++)
             tmp[i] = buffer[i];
@@ -707,12 +529,7 @@ double dwgBuffer::getDefaultDouble(double d){
     } else if (b == 2){
         duint8 buffer[6];
         char *tmp=nullptr;
-        if (bitPos != 0) {
-            for (int i = 0; i < 6; i++)
-                buffer[i] = getRawChar8();
-        } else {
-        filestr->read (buffer,6);
-        }
+        getBytes(buffer, 6);
         tmp = reinterpret_cast<char*>(&d);
         for (int i = 2; i < 6; i++)
             tmp[i-2] = buffer[i];
@@ -831,31 +648,26 @@ duint16 dwgBuffer::getBERawShort16(){
 
 /* reads "size" bytes and stores in "buf" return false if fail */
 bool dwgBuffer::getBytes(unsigned char *buf, duint64 size){
-    duint8 tmp;
-    filestr->read (buf,size);
-    if (!filestr->good())
+    duint64 pos = getPosition();
+    if (size > dataSize - pos || ((bitOffset & 7) != 0 && size == dataSize - pos)) {
+        good = false;
         return false;
-
-    if (bitPos != 0){
-        for (duint64 i=0; i<size;i++){
-            tmp =  buf[i];
-            buf[i] = (currByte << bitPos) | (tmp >> (8 - bitPos));
-            currByte = tmp;
-        }
+    }
+    if ((bitOffset & 7) == 0) {
+        memcpy(buf, data + pos, size);
+        bitOffset += size * 8;
+    } else {
+        for (duint64 i=0; i<size;i++)
+            buf[i] = getBits(8);
     }
     return true;
 }
 
 duint16 dwgBuffer::crc8(duint16 dx,dint32 start,dint32 end){
-    duint64 pos = filestr->getPos();
-    filestr->setPos(start);
-    int n = end-start;
-    duint8 *tmpBuf = new duint8[n];
-    duint8 *p = tmpBuf;
-    filestr->read (tmpBuf,n);
-    filestr->setPos(pos);
-    if (!filestr->good())
+    if (start < 0 || end < start || static_cast<duint64>(end) > dataSize)
         return 0;
+    int n = end-start;
+    const duint8 *p = data + start;
 
     duint8 al;
 
@@ -865,27 +677,20 @@ duint16 dwgBuffer::crc8(duint16 dx,dint32 start,dint32 end){
     dx = dx ^ crctable[al & 0xFF];
     p++;
   }
-  delete[]tmpBuf;
   return(dx);
 }
 
 duint32 dwgBuffer::crc32(duint32 seed,dint32 start,dint32 end){
-    duint64 pos = filestr->getPos();
-    filestr->setPos(start);
-    int n = end-start;
-    duint8 *tmpBuf = new duint8[n];
-    duint8 *p = tmpBuf;
-    filestr->read (tmpBuf,n);
-    filestr->setPos(pos);
-    if (!filestr->good())
+    if (start < 0 || end < start || static_cast<duint64>(end) > dataSize)
         return 0;
+    int n = end-start;
+    const duint8 *p = data + start;
 
     duint32 invertedCrc = ~seed;
     while (n-- > 0) {
-    duint8 data = *p++;
-    invertedCrc = (invertedCrc >> 8) ^ crc32Table[(invertedCrc ^ data) & 0xff];
+    duint8 value = *p++;
+    invertedCrc = (invertedCrc >> 8) ^ crc32Table[(invertedCrc ^ value) & 0xff];
     }
-    delete[]tmpBuf;
     return ~invertedCrc;
 }
 
@@ -16,77 +16,35 @@
 #include <fstream>
 #include <sstream>
 #include <memory>
+#include <vector>
 #include "../drw_base.h"
 
 class DRW_Coord;
 class DRW_TextCodec;
 
-class dwgBasicStream{
-protected:
-    dwgBasicStream() = default;
-public:
-    virtual ~dwgBasicStream() = default;
-    virtual bool read(duint8* s, duint64 n) = 0;
-    virtual duint64 size() const = 0;
-    virtual duint64 getPos() const = 0;
-    virtual bool setPos(duint64 p) = 0;
-    virtual bool good() const = 0;
-    virtual dwgBasicStream* clone() const = 0;
-};
-
-class dwgFileStream: public dwgBasicStream{
-public:
-    explicit dwgFileStream(std::ifstream *s)
-        :stream{s}
-    {
-        stream->seekg (0, std::ios::end);
-        sz = stream->tellg();
-        stream->seekg(0, std::ios_base::beg);
-    }
-    bool read(duint8* s, duint64 n) override;
-    duint64 size() const override{return sz;}
-    duint64 getPos() const override{return stream->tellg();}
-    bool setPos(duint64 p) override;
-    bool good() const override{return stream->good();}
-    dwgBasicStream* clone() const override{return new dwgFileStream(stream);}
-private:
-    std::ifstream *stream{nullptr};
-    duint64 sz{0};
-};
-
-class dwgCharStream: public dwgBasicStream{
-public:
-    dwgCharStream(duint8 *buf, duint64 s)
-        :stream{buf}
-        ,sz{s}
-    {}
-    bool read(duint8* s, duint64 n) override;
-    duint64 size() const override {return sz;}
-    duint64 getPos() const override {return pos;}
-    bool setPos(duint64 p) override;
-    bool good() const override {return isOk;}
-    dwgBasicStream* clone() const override {return new dwgCharStream(stream, sz);}
-private:
-    duint8 *stream{nullptr};
-    duint64 sz{0};
-    duint64 pos{0};
-    bool isOk{true};
-};
-
+/**
+ * Bit reader for dwg data. Reads from a contiguous byte span, a file is
+ * loaded into memory once. Bits are extracted from a 64 bit big-endian
+ * word loaded at the current byte, without virtual calls or per byte
+ * reads.
+ */
 class dwgBuffer {
 public:
     dwgBuffer(std::ifstream *stream, DRW_TextCodec *decoder = nullptr);
-    dwgBuffer(duint8 *buf, duint64 size, DRW_TextCodec *decoder= nullptr);
-    dwgBuffer( const dwgBuffer& org );
-    dwgBuffer& operator=( const dwgBuffer& org );
+    dwgBuffer(const duint8 *buf, duint64 size, DRW_TextCodec *decoder= nullptr);
+    dwgBuffer( const dwgBuffer& org ) = default;
+    dwgBuffer& operator=( const dwgBuffer& org ) = default;
     virtual ~dwgBuffer() = default;
-    duint64 size() const {return filestr->size();}
+    duint64 size() const {return dataSize;}
     bool setPosition(duint64 pos);
-    duint64 getPosition() const;
+    duint64 getPosition() const {return bitOffset >> 3;}
     void resetPosition(){setPosition(0); setBitPos(0);}
     void setBitPos(duint8 pos);
-    duint8 getBitPos() const {return bitPos;}
+    duint8 getBitPos() const {return bitOffset & 7;}
     bool moveBitPos(dint32 size);
+    /** buffer over the next size bytes, shares the data instead of copying.
+     *  The position must be at a byte boundary. */
+    dwgBuffer getSubBuffer(duint64 size, DRW_TextCodec *decoder);
 
     duint8 getBit();  //B
     bool getBoolBit();  //B as bool
@@ -130,24 +88,49 @@ public:
 
     duint16 getBERawShort16();  //RS big-endian order
 
-    bool isGood() const {return filestr->good();}
+    bool isGood() const {return good;}
     bool getBytes(duint8 *buf, duint64 size);
-    int numRemainingBytes() const {return (maxSize- filestr->getPos());}
+    int numRemainingBytes() const {return dataSize - ((bitOffset + 7) >> 3);}
 
     duint16 crc8(duint16 dx,dint32 start,dint32 end);
     duint32 crc32(duint32 seed,dint32 start,dint32 end);
 
-//    duint8 getCurrByte(){return currByte;}
     DRW_TextCodec *decoder{nullptr};
 
 private:
-    std::unique_ptr<dwgBasicStream> filestr;
-    duint64 maxSize{0};
-    duint8 currByte{0};
-    duint8 bitPos{0};
-
+    //! keeps the file contents alive, if read from a stream
+    std::shared_ptr<const std::vector<duint8>> storage;
+    const duint8 *data{nullptr};
+    duint64 dataSize{0};
+    duint64 bitOffset{0};
+    bool good{true};
+
+    duint64 getBits(int n);
     UTF8STRING get8bitStr();
     UTF8STRING get16bitStr(duint16 textSize, bool nullTerm = true);
 };
 
+/** Reads n bits, 1 <= n <= 57, as an unsigned number, first bit highest **/
+inline duint64 dwgBuffer::getBits(int n){
+    duint64 const byte = bitOffset >> 3;
+    const duint8 *p = data + byte;
+    duint64 word = 0;
+    if (byte + 8 <= dataSize) {
+        word = static_cast<duint64>(p[0]) << 56 | static_cast<duint64>(p[1]) << 48
+             | static_cast<duint64>(p[2]) << 40 | static_cast<duint64>(p[3]) << 32
+             | static_cast<duint64>(p[4]) << 24 | static_cast<duint64>(p[5]) << 16
+             | static_cast<duint64>(p[6]) << 8 | static_cast<duint64>(p[7]);
+    } else {
+        for (duint64 i = 0; i < 8; i++)
+            word = word << 8 | (byte + i < dataSize ? p[i] : 0);
+    }
+    word = (word << (bitOffset & 7)) >> (64 - n);
+    bitOffset += n;
+    if (bitOffset > dataSize * 8) {
+        bitOffset = dataSize * 8;
+        good = false;
+    }
+    return word;
+}
+
 #endif // DWGBUFFER_H
@@ -10,6 +10,7 @@
 **  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
 ******************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -853,9 +854,7 @@ bool dwgReader::readPlineVertex(DRW_Polyline& pline, dwgBuffer *dbuf){
                 if (version > DRW::AC1021) {//2010+
                     bs = dbuf->getUModularChar();
                 }
-                std::vector<duint8> tmpByteStr(size);
-                dbuf->getBytes(tmpByteStr.data(), size);
-                dwgBuffer buff(tmpByteStr.data(), size, &decoder);
+                dwgBuffer buff = dbuf->getSubBuffer(size, &decoder);
                 dint16 oType = buff.getObjType(version);
                 buff.resetPosition();
                 DRW_DBG(" object type= "); DRW_DBG(oType); DRW_DBG("\n");
@@ -889,9 +888,7 @@ bool dwgReader::readPlineVertex(DRW_Polyline& pline, dwgBuffer *dbuf){
                 if (version > DRW::AC1021) {//2010+
                     bs = dbuf->getUModularChar();
                 }
-                std::vector<duint8> tmpByteStr(size);
-                dbuf->getBytes(tmpByteStr.data(), size);
-                dwgBuffer buff(tmpByteStr.data(), size, &decoder);
+                dwgBuffer buff = dbuf->getSubBuffer(size, &decoder);
                 dint16 oType = buff.getObjType(version);
                 buff.resetPosition();
                 DRW_DBG(" object type= "); DRW_DBG(oType); DRW_DBG("\n");
@@ -909,20 +906,73 @@ bool dwgReader::readPlineVertex(DRW_Polyline& pline, dwgBuffer *dbuf){
     return ret;
 }
 
+/**
+ * Reads the entities left in the object map after tables and blocks.
+ * Objects are read in file order, in batches decoded concurrently, and
+ * delivered to the interface in file order. Objects which are not
+ * entities stay in the map until all entities are read, polylines take
+ * their vertices from it.
+ */
 bool dwgReader::readDwgEntities(DRW_Interface& intfa, dwgBuffer *dbuf){
     bool ret = true;
-    bool ret2 = true;
 
     DRW_DBG("\nobject map total size= "); DRW_DBG(ObjectMap.size());
-    auto itB=ObjectMap.begin();
-    auto itE=ObjectMap.end();
-    while (itB != itE){
-        ret2 = readDwgEntity(dbuf, itB->second, intfa);
-        ObjectMap.erase(itB);
-        itB=ObjectMap.begin();
-        if (ret)
-            ret = ret2;
+    std::vector<objHandle> objects;
+    objects.reserve(ObjectMap.size());
+    for (const auto& it: ObjectMap)
+        objects.push_back(it.second);
+    std::sort(objects.begin(), objects.end(), [](const objHandle& a, const objHandle& b){
+        return a.loc < b.loc || (a.loc == b.loc && a.handle < b.handle);
+    });
+
+    //debug output of concurrent parsers would be interleaved
+    bool concurrent = DRW_DBGGL != DRW_dbg::Level::Debug;
+    const size_t batchSize = 4096;
+    std::vector<std::unique_ptr<DRW_Entity>> entities;
+    std::vector<char> parsed;
+    std::vector<objHandle> notEntities;
+    for (size_t start = 0; start < objects.size(); start += batchSize) {
+        size_t count = std::min(batchSize, objects.size() - start);
+        entities.clear();
+        entities.resize(count);
+        parsed.assign(count, false);
+        DRW::forEachRange(count, 64, concurrent, [&](size_t begin, size_t end){
+            dwgBuffer buff(*dbuf);
+            for (size_t i = begin; i < end; i++) {
+                try {
+                    parsed[i] = parseDwgEntity(&buff, objects[start + i], entities[i]);
+                } catch (...) {
+                    parsed[i] = false;
+                    entities[i].reset();
+                }
+            }
+        });
+
+        for (size_t i = 0; i < count; i++) {
+            objHandle& obj = objects[start + i];
+            auto it = ObjectMap.find(obj.handle);
+            //already read as vertex of a polyline
+            if (it == ObjectMap.end())
+                continue;
+            if (!entities[i]) {
+                if (parsed[i])
+                    notEntities.push_back(obj);
+                else
+                    ret = false;
+                continue;
+            }
+            ObjectMap.erase(it);
+            addDwgEntity(entities[i].get(), obj, dbuf, intfa);
+            if (!parsed[i])
+                ret = false;
+        }
+    }
+
+    for (const objHandle& obj: notEntities) {
+        if (ObjectMap.erase(obj.handle) > 0)
+            objObjectMap[obj.handle]= obj;
     }
+    ObjectMap.clear();
     return ret;
 }
 
@@ -930,16 +980,32 @@ bool dwgReader::readDwgEntities(DRW_Interface& intfa, dwgBuffer *dbuf){
  * Reads a dwg drawing entity (dwg object entity) given its offset in the file
  */
 bool dwgReader::readDwgEntity(dwgBuffer *dbuf, objHandle& obj, DRW_Interface& intfa){
-    bool ret = true;
-    duint32 bs = 0;
+    std::unique_ptr<DRW_Entity> e;
+    bool ret = parseDwgEntity(dbuf, obj, e);
+    nextEntLink = prevEntLink = 0;// set to 0 to skip unimplemented entities
+    if (!e) {
+        //not supported or are object add to remaining map
+        if (ret)
+            objObjectMap[obj.handle]= obj;
+        return ret;
+    }
+    nextEntLink = e->nextEntLink;
+    prevEntLink = e->prevEntLink;
+    addDwgEntity(e.get(), obj, dbuf, intfa);
+    return ret;
+}
 
-#define ENTRY_PARSE(e) \
-    ret = e.parseDwg(version, &buff, bs); \
-    parseAttribs(&e); \
-    nextEntLink = e.nextEntLink; \
-    prevEntLink = e.prevEntLink;
+/**
+ * Parses the entity at the offset of obj, sets the type of obj.
+ * Reads only from the buffer and the tables, can run concurrently
+ * with separate buffers.
+ * @param entity parsed entity, null if obj is no supported entity
+ * @return false if the entity could not be read
+ */
+bool dwgReader::parseDwgEntity(dwgBuffer *dbuf, objHandle& obj, std::unique_ptr<DRW_Entity>& entity){
+    duint32 bs = 0;
+    entity.reset();
 
-    nextEntLink = prevEntLink = 0;// set to 0 to skip unimplemented entities
         dbuf->setPosition(obj.loc);
         //verify if position is ok:
         if (!dbuf->isGood()){
@@ -950,14 +1016,12 @@ bool dwgReader::readDwgEntity(dwgBuffer *dbuf, objHandle& obj, DRW_Interface& in
         if (version > DRW::AC1021) {//2010+
             bs = dbuf->getUModularChar();
         }
-        std::vector<duint8> tmpByteStr(size);
-        dbuf->getBytes(tmpByteStr.data(), size);
-        //verify if getBytes is ok:
+        dwgBuffer buff = dbuf->getSubBuffer(size, &decoder);
+        //verify if size is ok:
         if (!dbuf->isGood()){
             DRW_DBG(" Warning: readDwgEntity, bad size\n");
             return false;
         }
-        dwgBuffer buff(tmpByteStr.data(), size, &decoder);
         dint16 oType = buff.getObjType(version);
         buff.resetPosition();
 
@@ -975,171 +1039,218 @@ bool dwgReader::readDwgEntity(dwgBuffer *dbuf, objHandle& obj, DRW_Interface& in
 
         obj.type = oType;
         switch (oType){
-        case 17: {
-            DRW_Arc e;
-            ENTRY_PARSE(e)
-            intfa.addArc(e);
-            break; }
-        case 18: {
-            DRW_Circle e;
-            ENTRY_PARSE(e)
-            intfa.addCircle(e);
-            break; }
-        case 19:{
-            DRW_Line e;
-            ENTRY_PARSE(e)
-            intfa.addLine(e);
-            break;}
-        case 27: {
-            DRW_Point e;
-            ENTRY_PARSE(e)
-            intfa.addPoint(e);
-            break; }
-        case 35: {
-            DRW_Ellipse e;
-            ENTRY_PARSE(e)
-            intfa.addEllipse(e);
-            break; }
+        case 17:
+            entity.reset(new DRW_Arc());
+            break;
+        case 18:
+            entity.reset(new DRW_Circle());
+            break;
+        case 19:
+            entity.reset(new DRW_Line());
+            break;
+        case 27:
+            entity.reset(new DRW_Point());
+            break;
+        case 35:
+            entity.reset(new DRW_Ellipse());
+            break;
+        case 7:
+        case 8: //minsert = 8
+            entity.reset(new DRW_Insert());
+            break;
+        case 77:
+            entity.reset(new DRW_LWPolyline());
+            break;
+        case 1:
+            entity.reset(new DRW_Text());
+            break;
+        case 44:
+            entity.reset(new DRW_MText());
+            break;
+        case 28:
+            entity.reset(new DRW_3Dface());
+            break;
+        case 20:
+            entity.reset(new DRW_DimOrdinate());
+            break;
+        case 21:
+            entity.reset(new DRW_DimLinear());
+            break;
+        case 22:
+            entity.reset(new DRW_DimAligned());
+            break;
+        case 23:
+            entity.reset(new DRW_DimAngular3p());
+            break;
+        case 24:
+            entity.reset(new DRW_DimAngular());
+            break;
+        case 25:
+            entity.reset(new DRW_DimRadial());
+            break;
+        case 26:
+            entity.reset(new DRW_DimDiametric());
+            break;
+        case 45:
+            entity.reset(new DRW_Leader());
+            break;
+        case 31:
+            entity.reset(new DRW_Solid());
+            break;
+        case 78:
+            entity.reset(new DRW_Hatch());
+            break;
+        case 32:
+            entity.reset(new DRW_Trace());
+            break;
+        case 34:
+            entity.reset(new DRW_Viewport());
+            break;
+        case 36:
+            entity.reset(new DRW_Spline());
+            break;
+        case 40:
+            entity.reset(new DRW_Ray());
+            break;
+        case 15:    // pline 2D
+        case 16:    // pline 3D
+        case 29:    // pline PFACE
+            entity.reset(new DRW_Polyline());
+            break;
+//        case 30:
+//            DRW_Polyline e;// MESH (not pline)
+        case 41:
+            entity.reset(new DRW_Xline());
+            break;
+        case 101:
+            entity.reset(new DRW_Image());
+            break;
+        default:
+            return true;
+        }
+        bool ret = entity->parseDwg(version, &buff, bs);
+        parseAttribs(entity.get());
+        if (!ret){
+            DRW_DBG("Warning: Entity type "); DRW_DBG(oType);DRW_DBG("has failed, handle: "); DRW_DBG(obj.handle); DRW_DBG("\n");
+        }
+    return ret;
+}
+
+/**
+ * Completes a parsed entity with table names and polyline vertices and
+ * sends it to the interface
+ */
+void dwgReader::addDwgEntity(DRW_Entity *e, const objHandle& obj, dwgBuffer *dbuf, DRW_Interface& intfa){
+        switch (obj.type){
+        case 17:
+            intfa.addArc(*static_cast<DRW_Arc*>(e));
+            break;
+        case 18:
+            intfa.addCircle(*static_cast<DRW_Circle*>(e));
+            break;
+        case 19:
+            intfa.addLine(*static_cast<DRW_Line*>(e));
+            break;
+        case 27:
+            intfa.addPoint(*static_cast<DRW_Point*>(e));
+            break;
+        case 35:
+            intfa.addEllipse(*static_cast<DRW_Ellipse*>(e));
+            break;
         case 7:
         case 8: {//minsert = 8
-            DRW_Insert e;
-            ENTRY_PARSE(e)
-            e.name = findTableName(DRW::BLOCK_RECORD, e.blockRecH.ref);//RLZ: find as block or blockrecord (ps & ps0)
-            intfa.addInsert(e);
-            break; }
-        case 77: {
-            DRW_LWPolyline e;
-            ENTRY_PARSE(e)
-            intfa.addLWPolyline(e);
+            auto insert = static_cast<DRW_Insert*>(e);
+            insert->name = findTableName(DRW::BLOCK_RECORD, insert->blockRecH.ref);//RLZ: find as block or blockrecord (ps & ps0)
+            intfa.addInsert(*insert);
             break; }
+        case 77:
+            intfa.addLWPolyline(*static_cast<DRW_LWPolyline*>(e));
+            break;
         case 1: {
-            DRW_Text e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::STYLE, e.styleH.ref);
-            intfa.addText(e);
+            auto text = static_cast<DRW_Text*>(e);
+            text->style = findTableName(DRW::STYLE, text->styleH.ref);
+            intfa.addText(*text);
             break; }
         case 44: {
-            DRW_MText e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::STYLE, e.styleH.ref);
-            intfa.addMText(e);
-            break; }
-        case 28: {
-            DRW_3Dface e;
-            ENTRY_PARSE(e)
-            intfa.add3dFace(e);
-            break; }
-        case 20: {
-            DRW_DimOrdinate e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addDimOrdinate(&e);
-            break; }
-        case 21: {
-            DRW_DimLinear e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addDimLinear(&e);
-            break; }
-        case 22: {
-            DRW_DimAligned e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addDimAlign(&e);
-            break; }
-        case 23: {
-            DRW_DimAngular3p e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addDimAngular3P(&e);
-            break; }
-        case 24: {
-            DRW_DimAngular e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addDimAngular(&e);
-            break; }
-        case 25: {
-            DRW_DimRadial e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addDimRadial(&e);
+            auto text = static_cast<DRW_MText*>(e);
+            text->style = findTableName(DRW::STYLE, text->styleH.ref);
+            intfa.addMText(*text);
             break; }
+        case 28:
+            intfa.add3dFace(*static_cast<DRW_3Dface*>(e));
+            break;
+        case 20:
+        case 21:
+        case 22:
+        case 23:
+        case 24:
+        case 25:
         case 26: {
-            DRW_DimDiametric e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addDimDiametric(&e);
+            auto dim = static_cast<DRW_Dimension*>(e);
+            dim->style = findTableName(DRW::DIMSTYLE, dim->dimStyleH.ref);
+            switch (obj.type){
+            case 20:
+                intfa.addDimOrdinate(static_cast<DRW_DimOrdinate*>(dim));
+                break;
+            case 21:
+                intfa.addDimLinear(static_cast<DRW_DimLinear*>(dim));
+                break;
+            case 22:
+                intfa.addDimAlign(static_cast<DRW_DimAligned*>(dim));
+                break;
+            case 23:
+                intfa.addDimAngular3P(static_cast<DRW_DimAngular3p*>(dim));
+                break;
+            case 24:
+                intfa.addDimAngular(static_cast<DRW_DimAngular*>(dim));
+                break;
+            case 25:
+                intfa.addDimRadial(static_cast<DRW_DimRadial*>(dim));
+                break;
+            default:
+                intfa.addDimDiametric(static_cast<DRW_DimDiametric*>(dim));
+                break;
+            }
             break; }
         case 45: {
-            DRW_Leader e;
-            ENTRY_PARSE(e)
-            e.style = findTableName(DRW::DIMSTYLE, e.dimStyleH.ref);
-            intfa.addLeader(&e);
-            break; }
-        case 31: {
-            DRW_Solid e;
-            ENTRY_PARSE(e)
-            intfa.addSolid(e);
-            break; }
-        case 78: {
-            DRW_Hatch e;
-            ENTRY_PARSE(e)
-            intfa.addHatch(&e);
-            break; }
-        case 32: {
-            DRW_Trace e;
-            ENTRY_PARSE(e)
-            intfa.addTrace(e);
-            break; }
-        case 34: {
-            DRW_Viewport e;
-            ENTRY_PARSE(e)
-            intfa.addViewport(e);
-            break; }
-        case 36: {
-            DRW_Spline e;
-            ENTRY_PARSE(e)
-            intfa.addSpline(&e);
-            break; }
-        case 40: {
-            DRW_Ray e;
-            ENTRY_PARSE(e)
-            intfa.addRay(e);
+            auto leader = static_cast<DRW_Leader*>(e);
+            leader->style = findTableName(DRW::DIMSTYLE, leader->dimStyleH.ref);
+            intfa.addLeader(leader);
             break; }
+        case 31:
+            intfa.addSolid(*static_cast<DRW_Solid*>(e));
+            break;
+        case 78:
+            intfa.addHatch(static_cast<DRW_Hatch*>(e));
+            break;
+        case 32:
+            intfa.addTrace(*static_cast<DRW_Trace*>(e));
+            break;
+        case 34:
+            intfa.addViewport(*static_cast<DRW_Viewport*>(e));
+            break;
+        case 36:
+            intfa.addSpline(static_cast<DRW_Spline*>(e));
+            break;
+        case 40:
+            intfa.addRay(*static_cast<DRW_Ray*>(e));
+            break;
         case 15:    // pline 2D
         case 16:    // pline 3D
         case 29: {  // pline PFACE
-            DRW_Polyline e;
-            ENTRY_PARSE(e)
-            readPlineVertex(e, dbuf);
-            intfa.addPolyline(e);
+            auto pline = static_cast<DRW_Polyline*>(e);
+            readPlineVertex(*pline, dbuf);
+            intfa.addPolyline(*pline);
             break; }
-//        case 30: {
-//            DRW_Polyline e;// MESH (not pline)
-//            ENTRY_PARSE(e)
-//            intfa.addRay(e);
-//            break; }
-        case 41: {
-            DRW_Xline e;
-            ENTRY_PARSE(e)
-            intfa.addXline(e);
-            break; }
-        case 101: {
-            DRW_Image e;
-            ENTRY_PARSE(e)
-            intfa.addImage(&e);
-            break; }
-
+        case 41:
+            intfa.addXline(*static_cast<DRW_Xline*>(e));
+            break;
+        case 101:
+            intfa.addImage(static_cast<DRW_Image*>(e));
+            break;
         default:
-            //not supported or are object add to remaining map
-            objObjectMap[obj.handle]= obj;
             break;
         }
-        if (!ret){
-            DRW_DBG("Warning: Entity type "); DRW_DBG(oType);DRW_DBG("has failed, handle: "); DRW_DBG(obj.handle); DRW_DBG("\n");
-        }
-    return ret;
 }
 
 bool dwgReader::readDwgObjects(DRW_Interface& intfa, dwgBuffer *dbuf){
@@ -1185,15 +1296,12 @@ bool dwgReader::readDwgObject(dwgBuffer *dbuf, objHandle& obj, DRW_Interface& in
         if (version > DRW::AC1021) {//2010+
             bs = dbuf->getUModularChar();
         }
-        duint8 *tmpByteStr = new duint8[size];
-        dbuf->getBytes(tmpByteStr, size);
-        //verify if getBytes is ok:
+        dwgBuffer buff = dbuf->getSubBuffer(size, &decoder);
+        //verify if size is ok:
         if (!dbuf->isGood()){
             DRW_DBG(" Warning: readDwgObject, bad size\n");
-            delete[]tmpByteStr;
             return false;
         }
-        dwgBuffer buff(tmpByteStr, size, &decoder);
         //oType are set parsing entities
         dint16 oType = obj.type;
 
@@ -1211,7 +1319,6 @@ bool dwgReader::readDwgObject(dwgBuffer *dbuf, objHandle& obj, DRW_Interface& in
         if (!ret){
             DRW_DBG("Warning: Object type "); DRW_DBG(oType);DRW_DBG("has failed, handle: "); DRW_DBG(obj.handle); DRW_DBG("\n");
         }
-        delete[]tmpByteStr;
     return ret;
 }
 
@@ -140,6 +140,8 @@ protected:
     virtual bool readDwgObjects(DRW_Interface& intfa) = 0;
 
     virtual bool readDwgEntity(dwgBuffer *dbuf, objHandle& obj, DRW_Interface& intfa);
+    bool parseDwgEntity(dwgBuffer *dbuf, objHandle& obj, std::unique_ptr<DRW_Entity>& entity);
+    void addDwgEntity(DRW_Entity *e, const objHandle& obj, dwgBuffer *dbuf, DRW_Interface& intfa);
     bool readDwgObject(dwgBuffer *dbuf, objHandle& obj, DRW_Interface& intfa);
     void parseAttribs(DRW_Entity* e);
     std::string findTableName(DRW::TTYPE table, dint32 handle);
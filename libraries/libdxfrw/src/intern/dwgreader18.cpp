@@ -10,6 +10,7 @@
 **  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
 ******************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -111,8 +112,14 @@ bool dwgReader18::parseSysPage(duint8 *decompSec, duint32 decompSize){
  //called ???: Section map: 0x4163003b
 bool dwgReader18::parseDataPage(const dwgSectionInfo &si/*, duint8 *dData*/){
     DRW_DBG("\nparseDataPage\n ");
-    objData.reset( new duint8 [si.pageCount * si.maxSize] );
-
+    duint64 dataSize = static_cast<duint64>(si.pageCount) * si.maxSize;
+    objData.reset( new duint8 [dataSize] );
+
+    //pages are read and checked in order, then decompressed concurrently
+    std::vector<dwgPageInfo> pageInfo;
+    std::vector<std::vector<duint8>> pageData;
+    pageInfo.reserve(si.pages.size());
+    pageData.reserve(si.pages.size());
     for (auto it=si.pages.begin(); it!=si.pages.end(); ++it){
         dwgPageInfo pi = it->second;
         if (!fileBuf->setPosition(pi.address))
@@ -165,15 +172,28 @@ bool dwgReader18::parseDataPage(const dwgSectionInfo &si/*, duint8 *dData*/){
         DRW_DBG("Calc header checksum= "); DRW_DBGH(calcsH);
         DRW_DBG("\nCalc data checksum= "); DRW_DBGH(calcsD); DRW_DBG("\n");
 
-        duint8* oData = objData.get() + pi.startOffset;
         pi.uSize = si.maxSize;
-        DRW_DBG("decompressing "); DRW_DBG(pi.cSize); DRW_DBG(" bytes in "); DRW_DBG(pi.uSize); DRW_DBG(" bytes\n");
-        dwgCompressor comp;
-        if (!comp.decompress18(cData.data(), oData, pi.cSize, pi.uSize)) {
+        if (pi.startOffset + pi.uSize > dataSize) {
+            DRW_DBG("WARNING: page start offset out of section\n");
             return false;
         }
+        DRW_DBG("decompressing "); DRW_DBG(pi.cSize); DRW_DBG(" bytes in "); DRW_DBG(pi.uSize); DRW_DBG(" bytes\n");
+        pageInfo.push_back(pi);
+        pageData.push_back(std::move(cData));
     }
-    return true;
+
+    //each page has its own compressor and output range, debug output stays in order
+    std::vector<char> pageOk(pageInfo.size(), 0);
+    bool concurrent = DRW_DBGGL != DRW_dbg::Level::Debug;
+    DRW::forEachRange(pageInfo.size(), 1, concurrent, [&](size_t begin, size_t end){
+        for (size_t i = begin; i < end; i++) {
+            const dwgPageInfo &pi = pageInfo[i];
+            dwgCompressor comp;
+            pageOk[i] = comp.decompress18(pageData[i].data(), objData.get() + pi.startOffset,
+                                          pi.cSize, pi.uSize);
+        }
+    });
+    return std::find(pageOk.begin(), pageOk.end(), 0) == pageOk.end();
 }
 
 bool dwgReader18::readMetaData() {
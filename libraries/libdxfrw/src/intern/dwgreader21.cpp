@@ -70,7 +70,8 @@ bool dwgReader21::parseSysPage(duint64 sizeCompressed, duint64 sizeUncompressed,
     std::vector<duint8> tmpDataRS(fpsize);
     dwgRSCodec::decode239I(&tmpDataRaw.front(), &tmpDataRS.front(), fpsize/255);
 
-    return dwgCompressor::decompress21(&tmpDataRS.front(), decompData, sizeCompressed, sizeUncompressed);
+    dwgCompressor comp;
+    return comp.decompress21(&tmpDataRS.front(), decompData, sizeCompressed, sizeUncompressed);
 }
 
 bool dwgReader21::parseDataPage(const dwgSectionInfo &si, duint8 *dData){
@@ -107,7 +108,8 @@ bool dwgReader21::parseDataPage(const dwgSectionInfo &si, duint8 *dData){
         DRW_DBG("\npage uncomp size: "); DRW_DBG(pi.uSize); DRW_DBG(" comp size: "); DRW_DBG(pi.cSize);
         DRW_DBG("\noffset: "); DRW_DBG(pi.startOffset);
         duint8 *pageData = dData + pi.startOffset;
-        if (!dwgCompressor::decompress21(&tmpPageRS.front(), pageData, pi.cSize, pi.uSize)) {
+        dwgCompressor comp;
+        if (!comp.decompress21(&tmpPageRS.front(), pageData, pi.cSize, pi.uSize)) {
             return false;
         }
 
@@ -166,8 +168,9 @@ bool dwgReader21::readFileHeader() {
         std::vector<duint8> compByteStr(fileHdrCompLength);
         fileHdrBuf.getBytes(compByteStr.data(), fileHdrCompLength);
         fileHdrData.resize(fileHdrDataLength);
-        if (!dwgCompressor::decompress21(compByteStr.data(), &fileHdrData.front(),
-                                         fileHdrCompLength, fileHdrDataLength)) {
+        dwgCompressor comp;
+        if (!comp.decompress21(compByteStr.data(), &fileHdrData.front(),
+                               fileHdrCompLength, fileHdrDataLength)) {
             return false;
         }
     }
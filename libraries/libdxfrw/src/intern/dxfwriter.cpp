@@ -143,6 +143,9 @@ bool dxfWriterBinary::writeString(int code, std::string text) {
 }*/
 
 bool dxfWriterBinary::writeInt16(int code, int data) {
+    //boolean flags written as int, are a single byte in binary files
+    if (code > 289 && code < 300)
+        return writeBool(code, data != 0);
     char bufcode[2];
     char buffer[2];
     bufcode[0] =code & 0xFF;
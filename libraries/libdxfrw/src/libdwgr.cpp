@@ -164,6 +164,13 @@ bool dwgR::read(DRW_Interface *interface_, bool ext){
     return isOk;
 }
 
+bool dwgR::probe(DRW_Interface *interface_){
+    probing = true;
+    bool isOk = read(interface_, false);
+    probing = false;
+    return isOk;
+}
+
 /**
  * Factory method which creates a reader for the specified DWG version.
  *
@@ -315,6 +322,9 @@ bool dwgR::processDwg() {
         iface->addAppId(const_cast<DRW_AppId&>(*ly));
     }
 
+    if (probing)
+        return ret;
+
     ret2 = reader->readDwgBlocks(*iface);
     if (ret && !ret2) {
         error = DRW::BAD_READ_BLOCKS;
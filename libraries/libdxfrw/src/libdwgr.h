@@ -30,6 +30,10 @@ public:
     ~dwgR();
     //read: return true if all ok
     bool read(DRW_Interface *interface_, bool ext);
+    //probe: reports only header and tables, return true if all ok. The whole
+    //file is still read and the objects section decompressed, the table
+    //records are objects of that section
+    bool probe(DRW_Interface *interface_);
     bool getPreview();
     DRW::Version getVersion(){return version;}
     DRW::error getError(){return error;}
@@ -46,6 +50,7 @@ private:
     DRW::error error { DRW::BAD_NONE };
     std::string fileName;
     bool applyExt { false }; /*apply extrusion in entities to conv in 2D?*/
+    bool probing { false }; /*stop after the tables?*/
     std::string codePage;
     DRW_Interface *iface { nullptr };
     std::unique_ptr< dwgReader > reader;
@@ -105,6 +105,15 @@ bool dxfRW::read(DRW_Interface *interface_, bool ext){
     return isOk;
 }
 
+bool dxfRW::probe(DRW_Interface *interface_, std::map<std::string, int> *entityCounts){
+    probing = true;
+    this->entityCounts = entityCounts;
+    bool isOk {read(interface_, false)};
+    probing = false;
+    this->entityCounts = nullptr;
+    return isOk;
+}
+
 bool dxfRW::write(DRW_Interface *interface_, DRW::Version ver, bool bin){
     bool isOk = false;
     std::ofstream filestr;
@@ -1917,11 +1926,18 @@ bool dxfRW::processDxf() {
                 }
                 else if ("TABLES" == sectionname) {
                     processed = processTables();
+                    if (processed && probing && nullptr == entityCounts) {
+                        return true;  //nothing more to probe
+                    }
                 }
                 else if ("BLOCKS" == sectionname) {
-                    processed = processBlocks();
+                    processed = probing ? skipSection() : processBlocks();
                 }
                 else if ("ENTITIES" == sectionname) {
+                    if (probing) {
+                        //objects follow, nothing more to probe
+                        return nullptr == entityCounts || countEntities();
+                    }
                     processed = processEntities(false);
                 }
                 else if ("OBJECTS" == sectionname) {
@@ -2216,6 +2232,40 @@ bool dxfRW::processBlocks() {
     return setError(DRW::BAD_READ_BLOCKS);
 }
 
+/** skips the current section, up to its ENDSEC */
+bool dxfRW::skipSection() {
+    DRW_DBG("dxfRW::skipSection\n");
+    int code;
+    while (reader->readRec(&code)) {
+        if (code == 0 && reader->getString() == "ENDSEC") {
+            return true;
+        }
+    }
+
+    return setError(DRW::BAD_READ_SECTION);
+}
+
+/** counts the entities of the ENTITIES section by type, without parsing them */
+bool dxfRW::countEntities() {
+    DRW_DBG("dxfRW::countEntities\n");
+    int code;
+    while (reader->readRec(&code)) {
+        if (code != 0) {
+            continue;
+        }
+        std::string name {reader->getString()};
+        if (name == "ENDSEC") {
+            return true;
+        }
+        //parts of polylines and inserts
+        if (name != "VERTEX" && name != "SEQEND" && name != "ATTRIB") {
+            ++(*entityCounts)[name];
+        }
+    }
+
+    return setError(DRW::BAD_READ_ENTITIES);
+}
+
 bool dxfRW::processBlock() {
     DRW_DBG("dxfRW::processBlock");
     int code;
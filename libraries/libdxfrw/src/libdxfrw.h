@@ -14,6 +14,7 @@
 #ifndef LIBDXFRW_H
 #define LIBDXFRW_H
 
+#include <map>
 #include <string>
 #include <unordered_map>
 #include "drw_entities.h"
@@ -39,6 +40,16 @@ public:
      * @return true for success
      */
     bool read(DRW_Interface *interface_, bool ext);
+    /// reads only the header and the tables of the file specified in constructor
+    /*!
+     * Blocks, entities and objects are not parsed, so reading is fast
+     * regardless of the file size.
+     * @param interface_ the interface to use
+     * @param entityCounts if not null, the entities section is skimmed and
+     * the number of entities of each type (DXF name) stored here
+     * @return true for success
+     */
+    bool probe(DRW_Interface *interface_, std::map<std::string, int> *entityCounts = nullptr);
     void setBinary(bool b) {binFile = b;}
 
     bool write(DRW_Interface *interface_, DRW::Version ver, bool bin);
@@ -86,6 +97,8 @@ private:
     bool processBlock();
     bool processEntities(bool isblock);
     bool processObjects();
+    bool skipSection();
+    bool countEntities();
 
     bool processLType();
     bool processLayer();
@@ -147,6 +160,8 @@ private:
     bool wlayer0;
     bool dimstyleStd;
     bool applyExt;
+    bool probing {false};
+    std::map<std::string, int> *entityCounts {nullptr};
     bool writingBlock;
     int elParts;  /*!< parts number when convert ellipse to polyline */
     std::unordered_map<std::string,int> blockMap;
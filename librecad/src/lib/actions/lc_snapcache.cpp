@@ -0,0 +1,313 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+#include "lc_snapcache.h"
+#include "rs_entitycontainer.h"
+#include "rs_debug.h"
+
+namespace {
+// entities covering more cells are kept in a separate list
+const std::int64_t maxCellsPerEntity = 64;
+
+/**
+ * Bounding box of an entity, extended by the centers of the entity and
+ * its sub entities, which can lie outside of the entity.
+ */
+void addCenters(RS_Entity const* e, LC_Rect& box)
+{
+	RS_Vector const center = e->getCenter();
+	if (center.valid)
+		box = box.merge(center);
+	if (!e->isContainer())
+		return;
+	for (RS_Entity const* child: *static_cast<RS_EntityContainer const*>(e))
+		if (child)
+			addCenters(child, box);
+}
+
+bool isSnapCandidate(LC_SnapCache::SnapKind kind, RS_Entity const* e)
+{
+	if (!e->isVisible())
+		return false;
+	// same filters as RS_EntityContainer::getNearestEndpoint() and friends
+	if (kind == LC_SnapCache::Endpoint)
+		return !e->getParent()->ignoredOnModification();
+	return !e->getParent()->ignoredSnap();
+}
+
+/**
+ * Cell size for about one entity per cell, rounded up to a power of two.
+ * Depends on the container only, not on the zoom factor of the view.
+ */
+double cellSizeFor(const RS_EntityContainer& cont)
+{
+	RS_Vector const extent = cont.getMax() - cont.getMin();
+	double const span = std::max(extent.x, extent.y);
+	double const n = static_cast<double>(std::max<unsigned>(cont.count(), 1));
+	double const size = span / std::sqrt(n);
+	if (!(std::isfinite(size) && size > RS_TOLERANCE))
+		return 1.;
+	return std::exp2(std::ceil(std::log2(size)));
+}
+}
+
+void LC_SnapCache::clear()
+{
+	container = nullptr;
+	generation = 0;
+	cellSize = 0.;
+	entities = Index{};
+	entitiesBuilt = false;
+	typeIndices.clear();
+}
+
+void LC_SnapCache::update(const RS_EntityContainer& cont)
+{
+	if (container == &cont && generation == cont.getGeneration())
+		return;
+
+	clear();
+	container = &cont;
+	generation = cont.getGeneration();
+	cellSize = cellSizeFor(cont);
+}
+
+void LC_SnapCache::insert(Index& index, RS_Entity* e, bool withCenters) const
+{
+	std::size_t const i = index.entities.size();
+	index.entities.push_back(e);
+	if (e->isConstruction()) {
+		index.large.push_back(i);
+		return;
+	}
+
+	LC_Rect box{e->getMin(), e->getMax()};
+	if (withCenters)
+		addCenters(e, box);
+	double const x0 = std::floor(box.minP().x / cellSize);
+	double const y0 = std::floor(box.minP().y / cellSize);
+	double const x1 = std::floor(box.maxP().x / cellSize);
+	double const y1 = std::floor(box.maxP().y / cellSize);
+	if (!(std::isfinite(x0) && std::isfinite(y0) && std::isfinite(x1) && std::isfinite(y1))
+			|| (x1 - x0 + 1.) * (y1 - y0 + 1.) > maxCellsPerEntity) {
+		index.large.push_back(i);
+		return;
+	}
+
+	for (auto ix = static_cast<std::int64_t>(x0); ix <= static_cast<std::int64_t>(x1); ++ix)
+		for (auto iy = static_cast<std::int64_t>(y0); iy <= static_cast<std::int64_t>(y1); ++iy)
+			index.cells[cellKey(ix, iy)].push_back(i);
+}
+
+/**
+ * @return entities which may be within range of pos, in container order
+ */
+std::vector<RS_Entity*> LC_SnapCache::candidates(const Index& index, const RS_Vector& pos,
+												 double range) const
+{
+	double const x0 = std::floor((pos.x - range) / cellSize);
+	double const y0 = std::floor((pos.y - range) / cellSize);
+	double const x1 = std::floor((pos.x + range) / cellSize);
+	double const y1 = std::floor((pos.y + range) / cellSize);
+	// a huge range is cheaper to handle by checking all entities
+	if ((x1 - x0 + 1.) * (y1 - y0 + 1.) > static_cast<double>(index.entities.size()))
+		return index.entities;
+
+	std::vector<std::size_t> found = index.large;
+	for (auto ix = static_cast<std::int64_t>(x0); ix <= static_cast<std::int64_t>(x1); ++ix) {
+		for (auto iy = static_cast<std::int64_t>(y0); iy <= static_cast<std::int64_t>(y1); ++iy) {
+			auto it = index.cells.find(cellKey(ix, iy));
+			if (it != index.cells.end())
+				found.insert(found.end(), it->second.begin(), it->second.end());
+		}
+	}
+	std::sort(found.begin(), found.end());
+	found.erase(std::unique(found.begin(), found.end()), found.end());
+
+	std::vector<RS_Entity*> ret;
+	ret.reserve(found.size());
+	for (std::size_t i: found)
+		ret.push_back(index.entities[i]);
+	return ret;
+}
+
+/**
+ * Calls visit for the large entities and then for the entities in the cells
+ * around pos, ring by ring. visit returns the smallest distance found so
+ * far. The search stops when that distance is within the searched square,
+ * all points of an entity are inside of its cells, or when the square
+ * covers the range.
+ */
+void LC_SnapCache::visitRings(const Index& index, const RS_Vector& pos, double range,
+							  const std::function<double(std::size_t)>& visit) const
+{
+	double best = RS_MAXDOUBLE;
+	for (std::size_t i: index.large)
+		best = std::min(best, visit(i));
+
+	double const cx = std::floor(pos.x / cellSize);
+	double const cy = std::floor(pos.y / cellSize);
+	double const rings = std::ceil(range / cellSize);
+	if (!(std::isfinite(cx) && std::isfinite(cy) && std::isfinite(rings)))
+		return;
+	// a huge range is cheaper to handle by checking all entities
+	if ((2. * rings + 1.) * (2. * rings + 1.) > static_cast<double>(index.entities.size())) {
+		for (std::size_t i = 0; i < index.entities.size(); ++i)
+			visit(i);
+		return;
+	}
+
+	auto const x = static_cast<std::int64_t>(cx);
+	auto const y = static_cast<std::int64_t>(cy);
+	auto const maxRing = static_cast<std::int64_t>(rings);
+	std::unordered_set<std::size_t> visited{index.large.begin(), index.large.end()};
+	auto visitCell = [&](std::int64_t ix, std::int64_t iy) {
+		auto it = index.cells.find(cellKey(ix, iy));
+		if (it == index.cells.end())
+			return;
+		for (std::size_t i: it->second) {
+			if (visited.insert(i).second)
+				best = std::min(best, visit(i));
+		}
+	};
+
+	for (std::int64_t r = 0; r <= maxRing; ++r) {
+		if (r == 0) {
+			visitCell(x, y);
+		} else {
+			for (std::int64_t ix = x - r; ix <= x + r; ++ix) {
+				visitCell(ix, y - r);
+				visitCell(ix, y + r);
+			}
+			for (std::int64_t iy = y - r + 1; iy < y + r; ++iy) {
+				visitCell(x - r, iy);
+				visitCell(x + r, iy);
+			}
+		}
+		// distance from pos to the border of the searched square
+		double const inner = std::min({pos.x - (x - r) * cellSize,
+									   (x + r + 1) * cellSize - pos.x,
+									   pos.y - (y - r) * cellSize,
+									   (y + r + 1) * cellSize - pos.y});
+		if (best <= inner || inner >= range)
+			return;
+	}
+}
+
+RS_Vector LC_SnapCache::getNearest(SnapKind kind, const RS_EntityContainer& cont,
+								   const RS_Vector& coord, double range,
+								   int middlePoints)
+{
+	if (!(coord.valid && range > 0.))
+		return RS_Vector(false);
+
+	update(cont);
+	if (!entitiesBuilt) {
+		for (RS_Entity* e: cont) {
+			if (e)
+				insert(entities, e, true);
+		}
+		entitiesBuilt = true;
+		RS_DEBUG->print("LC_SnapCache::getNearest: cell size %g, %d cells, %d large entities",
+						cellSize, static_cast<int>(entities.cells.size()),
+						static_cast<int>(entities.large.size()));
+	}
+
+	double minDist = RS_MAXDOUBLE;
+	std::size_t closestIndex = 0;
+	RS_Vector closestPoint(false);
+	visitRings(entities, coord, range, [&](std::size_t i) {
+		RS_Entity* e = entities.entities[i];
+		if (!isSnapCandidate(kind, e))
+			return minDist;
+		double curDist = RS_MAXDOUBLE;
+		RS_Vector point;
+		switch (kind) {
+		case Endpoint:
+			point = e->getNearestEndpoint(coord, &curDist);
+			break;
+		case Center:
+			point = e->getNearestCenter(coord, &curDist);
+			break;
+		default:
+			point = e->getNearestMiddle(coord, &curDist, middlePoints);
+			break;
+		}
+		// of equally distant points the first in container order wins, as
+		// in RS_EntityContainer::getNearestEndpoint()
+		if (point.valid && (curDist < minDist
+							|| (curDist == minDist && i < closestIndex))) {
+			closestPoint = point;
+			closestIndex = i;
+			minDist = curDist;
+		}
+		return minDist;
+	});
+
+	return minDist <= range ? closestPoint : RS_Vector(false);
+}
+
+RS_Entity* LC_SnapCache::getNearestEntity(const RS_EntityContainer& cont,
+										  const RS_Vector& pos, double range,
+										  RS2::EntityType type, RS2::ResolveLevel level)
+{
+	if (!pos.valid)
+		return nullptr;
+
+	update(cont);
+	auto const key = std::make_pair(static_cast<int>(type), static_cast<int>(level));
+	auto it = typeIndices.find(key);
+	if (it == typeIndices.end()) {
+		it = typeIndices.emplace(key, Index{}).first;
+		// entities inside of polylines and splines match their owner's type
+		bool const isContainer = type == RS2::EntityPolyline
+				|| type == RS2::EntityContainer
+				|| type == RS2::EntitySpline;
+		for (RS_Entity* en: cont.deepEntities(level)) {
+			bool match = en->rtti() == type;
+			for (RS_Entity* parent = en->getParent(); isContainer && !match && parent;
+				 parent = parent->getParent())
+				match = parent->rtti() == type;
+			if (match)
+				insert(it->second, en, false);
+		}
+	}
+
+	// same tie breaking as RS_EntityContainer::getDistanceToPoint(), the
+	// last of equally distant entities wins
+	double minDist = RS_MAXDOUBLE;
+	RS_Entity* closest = nullptr;
+	for (RS_Entity* e: candidates(it->second, pos, range)) {
+		if (!e->isVisible())
+			continue;
+		// 0 is the distance for points inside of solids
+		double const curDist = e->getDistanceToPoint(pos, nullptr, RS2::ResolveNone, 0.);
+		if (curDist <= minDist) {
+			closest = e;
+			minDist = curDist;
+		}
+	}
+	return (closest && minDist <= range) ? closest : nullptr;
+}
@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_SNAPCACHE_H
+#define LC_SNAPCACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rs.h"
+#include "lc_rect.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Spatial hash of the entities of a container, used by RS_Snapper to find
+ * endpoints, centers and middle points near the mouse cursor without
+ * walking all entities. For type filtered picking (catchEntity()) a
+ * separate index is kept per entity type and resolve level.
+ *
+ * Each graphic view holds one cache. The cache is rebuilt when the
+ * container changes (see RS_EntityContainer::getGeneration()). The cell
+ * size is derived from the extent and the number of entities of the
+ * container, in graph units, so zooming and panning keep the cache.
+ * Lookups search the cells around the cursor ring by ring, up to the
+ * given range.
+ */
+class LC_SnapCache {
+public:
+	enum SnapKind {
+		Endpoint,
+		Center,
+		Middle
+	};
+
+	/**
+	 * @brief getNearest nearest snap point of the given kind
+	 * @param kind endpoint, center or middle point
+	 * @param container entities to snap to
+	 * @param coord mouse coordinate
+	 * @param range maximum distance of the point
+	 * @param middlePoints number of equidistant middle points
+	 * @return the nearest point or an invalid vector if there's no point
+	 * within range
+	 */
+	RS_Vector getNearest(SnapKind kind, const RS_EntityContainer& container,
+						 const RS_Vector& coord, double range,
+						 int middlePoints = 1);
+
+	/**
+	 * @brief getNearestEntity nearest visible entity of the given type,
+	 * entities inside containers of the given type (polylines, splines)
+	 * are found as well
+	 * @param container entities to search, iterated with the given level
+	 * @param pos position
+	 * @param range maximum distance
+	 * @param type entity type
+	 * @param level resolve level for iterating the container
+	 * @return the entity or nullptr if there's no entity within range
+	 */
+	RS_Entity* getNearestEntity(const RS_EntityContainer& container,
+								const RS_Vector& pos, double range,
+								RS2::EntityType type, RS2::ResolveLevel level);
+
+	/** drop all cached entities */
+	void clear();
+
+private:
+	/**
+	 * Entities in cells. Entities are referenced by their index in the
+	 * entity list to keep the container order.
+	 */
+	struct Index {
+		std::vector<RS_Entity*> entities;
+		//! entity indices by cell
+		std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells;
+		//! entities covering too many cells, always checked
+		std::vector<std::size_t> large;
+	};
+
+	void update(const RS_EntityContainer& container);
+	void insert(Index& index, RS_Entity* entity, bool withCenters) const;
+	std::vector<RS_Entity*> candidates(const Index& index, const RS_Vector& pos,
+									   double range) const;
+	void visitRings(const Index& index, const RS_Vector& pos, double range,
+					const std::function<double(std::size_t)>& visit) const;
+	std::uint64_t cellKey(std::int64_t ix, std::int64_t iy) const {
+		// the low 32 bits of both indices, shifted as unsigned values
+		return static_cast<std::uint64_t>(static_cast<std::uint32_t>(ix)) << 32
+				| static_cast<std::uint32_t>(iy);
+	}
+
+	RS_EntityContainer const* container = nullptr;
+	unsigned long long generation = 0;
+	double cellSize = 0.;
+	//! top level entities, built on the first snap
+	Index entities;
+	bool entitiesBuilt = false;
+	//! type filtered entities by type and resolve level
+	std::map<std::pair<int, int>, Index> typeIndices;
+};
+
+#endif // LC_SNAPCACHE_H
@@ -39,6 +39,7 @@
 #include "rs_overlayline.h"
 #include "rs_coordinateevent.h"
 #include "rs_entitycontainer.h"
+#include "lc_snapcache.h"
 #include "rs_pen.h"
 #include "rs_debug.h"
 
@@ -431,8 +432,8 @@ RS_Vector RS_Snapper::snapFree(const RS_Vector& coord) {
 RS_Vector RS_Snapper::snapEndpoint(const RS_Vector& coord) {
     RS_Vector vec(false);
 
-    vec = container->getNearestEndpoint(coord,
-										nullptr/*, &keyEntity*/);
+    vec = graphicView->getSnapCache()->getNearest(LC_SnapCache::Endpoint, *container,
+                                                  coord, getSnapRange());
     return vec;
 }
 
@@ -480,7 +481,8 @@ RS_Vector RS_Snapper::snapOnEntity(const RS_Vector& coord) {
 RS_Vector RS_Snapper::snapCenter(const RS_Vector& coord) {
 	RS_Vector vec{};
 
-	vec = container->getNearestCenter(coord, nullptr);
+	vec = graphicView->getSnapCache()->getNearest(LC_SnapCache::Center, *container,
+												  coord, getSnapRange());
     return vec;
 }
 
@@ -494,7 +496,8 @@ RS_Vector RS_Snapper::snapCenter(const RS_Vector& coord) {
  */
 RS_Vector RS_Snapper::snapMiddle(const RS_Vector& coord) {
 //std::cout<<"RS_Snapper::snapMiddle(): middlePoints="<<middlePoints<<std::endl;
-	return container->getNearestMiddle(coord,static_cast<double *>(nullptr),middlePoints);
+	return graphicView->getSnapCache()->getNearest(LC_SnapCache::Middle, *container,
+												   coord, getSnapRange(), middlePoints);
 }
 
 
@@ -635,52 +638,15 @@ RS_Entity* RS_Snapper::catchEntity(const RS_Vector& pos, RS2::EntityType enType,
     RS_DEBUG->print("RS_Snapper::catchEntity");
 //                    std::cout<<"RS_Snapper::catchEntity(): enType= "<<enType<<std::endl;
 
-    // set default distance for points inside solids
-	RS_EntityContainer ec(nullptr,false);
-	//isContainer
-	bool isContainer{false};
-	switch(enType){
-	case RS2::EntityPolyline:
-	case RS2::EntityContainer:
-	case RS2::EntitySpline:
-		isContainer=true;
-		break;
-	default:
-		break;
-	}
-
-	for(RS_Entity* en= container->firstEntity(level);en;en=container->nextEntity(level)){
-        if(en->isVisible()==false) continue;
-		if(en->rtti() != enType && isContainer){
-            //whether this entity is a member of member of the type enType
-            RS_Entity* parent(en->getParent());
-			bool matchFound{false};
-			while(parent ) {
-//                    std::cout<<"RS_Snapper::catchEntity(): parent->rtti()="<<parent->rtti()<<" enType= "<<enType<<std::endl;
-                if(parent->rtti() == enType) {
-                    matchFound=true;
-                    ec.addEntity(en);
-                    break;
-                }
-                parent=parent->getParent();
-            }
-			if(!matchFound) continue;
-        }
-        if (en->rtti() == enType){
-            ec.addEntity(en);
-        }
-    }
-	if (ec.count() == 0 ) return nullptr;
-    double dist(0.);
-
-    RS_Entity* entity = ec.getNearestEntity(pos, &dist, RS2::ResolveNone);
+	RS_Entity* entity = graphicView->getSnapCache()->getNearestEntity(
+				*container, pos, getSnapRange(), enType, level);
 
         int idx = -1;
 		if (entity && entity->getParent()) {
                 idx = entity->getParent()->findEntity(entity);
         }
 
-	if (entity && dist<=getSnapRange()) {
+	if (entity) {
         // highlight:
         RS_DEBUG->print("RS_Snapper::catchEntity: found: %d", idx);
         return entity;
@@ -736,19 +702,19 @@ RS_Entity* RS_Snapper::catchEntity(QMouseEvent* e, const EntityTypeList& enTypeL
     default:
     {
 
-		RS_EntityContainer ec(nullptr,false);
+		// nearest of the entities caught per type, the last one wins ties
+		double minDist = RS_MAXDOUBLE;
 		for( auto t0: enTypeList){
 			RS_Entity* en=catchEntity(coord, t0, level);
-			if(en) ec.addEntity(en);
-//			if(en) {
-//            std::cout<<__FILE__<<" : "<<__func__<<" : lines "<<__LINE__<<std::endl;
-//            std::cout<<"caught id= "<<en->getId()<<std::endl;
-//            }
-        }
-        if(ec.count()>0){
-            ec.getDistanceToPoint(coord, &pten, RS2::ResolveNone);
-            return pten;
+			if (en && en->isVisible()) {
+				double const dist = en->getDistanceToPoint(coord, nullptr, RS2::ResolveNone);
+				if (dist <= minDist) {
+					minDist = dist;
+					pten = en;
+				}
+			}
         }
+        return pten;
     }
 
     }
@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <algorithm>
+#include <numeric>
+
+#include "lc_broadphase.h"
+
+std::vector<std::pair<std::size_t, std::size_t>> LC_BroadPhase::overlappingPairs(
+		const std::vector<LC_Rect>& boxes, double tolerance)
+{
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+
+	std::vector<std::size_t> order(boxes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&boxes](std::size_t a, std::size_t b) {
+		return boxes[a].minP().x < boxes[b].minP().x;
+	});
+
+	// boxes which still reach the current sweep position
+	std::vector<std::size_t> active;
+	for (std::size_t i: order) {
+		LC_Rect const& box = boxes[i];
+		double const sweepX = box.minP().x - tolerance;
+		active.erase(std::remove_if(active.begin(), active.end(),
+									[&boxes, sweepX](std::size_t j) {
+			return boxes[j].maxP().x < sweepX;
+		}), active.end());
+
+		for (std::size_t j: active) {
+			LC_Rect const& other = boxes[j];
+			if (other.minP().y > box.maxP().y + tolerance
+					|| box.minP().y > other.maxP().y + tolerance)
+				continue;
+			pairs.emplace_back(std::min(i, j), std::max(i, j));
+		}
+		active.push_back(i);
+	}
+
+	std::sort(pairs.begin(), pairs.end());
+	return pairs;
+}
@@ -0,0 +1,50 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_BROADPHASE_H
+#define LC_BROADPHASE_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "lc_rect.h"
+
+/**
+ * Broad phase for all-pairs queries on bounding boxes.
+ *
+ * Boxes are swept along x (sort and prune), only boxes overlapping in x
+ * are tested in y. Unbounded entities like construction lines should be
+ * passed with a box covering the whole drawing.
+ */
+class LC_BroadPhase {
+public:
+	/**
+	 * @brief overlappingPairs find all pairs of overlapping boxes
+	 * @param boxes bounding boxes
+	 * @param tolerance boxes closer than tolerance are treated as overlapping
+	 * @return index pairs {i, j} with i < j, sorted
+	 */
+	static std::vector<std::pair<std::size_t, std::size_t>> overlappingPairs(
+			const std::vector<LC_Rect>& boxes, double tolerance = 0.);
+};
+
+#endif // LC_BROADPHASE_H
@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include "lc_entityiterator.h"
+#include "rs_entitycontainer.h"
+
+LC_EntityIterator::LC_EntityIterator(const RS_EntityContainer& container,
+									 RS2::ResolveLevel level):
+	level(level)
+{
+	push(container);
+	advance();
+}
+
+bool LC_EntityIterator::isResolved(RS_Entity const* e, RS2::ResolveLevel level)
+{
+	if (!e->isContainer())
+		return false;
+
+	// same rules as RS_EntityContainer::nextEntity()
+	switch (level) {
+	case RS2::ResolveAllButInserts:
+		return e->rtti() != RS2::EntityInsert;
+	case RS2::ResolveAllButTextImage:
+	case RS2::ResolveAllButTexts:
+		return e->rtti() != RS2::EntityText && e->rtti() != RS2::EntityMText;
+	case RS2::ResolveAll:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void LC_EntityIterator::push(const RS_EntityContainer& container)
+{
+	stack.push_back({container.begin(), container.end()});
+}
+
+void LC_EntityIterator::advance()
+{
+	current = nullptr;
+	while (!stack.empty()) {
+		Frame& frame = stack.back();
+		if (frame.it == frame.end) {
+			stack.pop_back();
+			continue;
+		}
+
+		RS_Entity* e = *frame.it;
+		++frame.it;
+		if (!e || e->isUndone())
+			continue;
+
+		if (isResolved(e, level)) {
+			// frame is invalidated by push()
+			push(*static_cast<RS_EntityContainer const*>(e));
+			continue;
+		}
+
+		current = e;
+		return;
+	}
+}
+
+LC_EntityRange::LC_EntityRange(const RS_EntityContainer& container,
+							   RS2::ResolveLevel level):
+	container(container)
+	,level(level)
+{
+}
+
+LC_EntityIterator LC_EntityRange::begin() const
+{
+	return {container, level};
+}
+
+LC_EntityIterator LC_EntityRange::end() const
+{
+	return {};
+}
+
+void LC_EntityRange::forEach(const std::function<void(RS_Entity*)>& visitor) const
+{
+	for (RS_Entity* e: *this)
+		visitor(e);
+}
+
+std::vector<RS_Entity*> LC_EntityRange::toVector() const
+{
+	std::vector<RS_Entity*> ret;
+	for (RS_Entity* e: *this)
+		ret.push_back(e);
+	return ret;
+}
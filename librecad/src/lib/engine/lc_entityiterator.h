@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_ENTITYITERATOR_H
+#define LC_ENTITYITERATOR_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <QList>
+
+#include "rs.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Depth first iterator over the entities of a container.
+ *
+ * Unlike RS_EntityContainer::firstEntity() / nextEntity() the iterator keeps
+ * its position on its own stack, so any number of iterators can traverse
+ * the same container at the same time, also from different threads. The
+ * container must not be modified while it is traversed.
+ *
+ * Sub containers are resolved like with nextEntity() for the given
+ * RS2::ResolveLevel, resolved containers are not returned themselves.
+ * Undone entities and their sub entities are skipped.
+ */
+class LC_EntityIterator {
+public:
+	using iterator_category = std::input_iterator_tag;
+	using value_type = RS_Entity*;
+	using difference_type = std::ptrdiff_t;
+	using pointer = RS_Entity* const*;
+	using reference = RS_Entity* const&;
+
+	/** end iterator */
+	LC_EntityIterator() = default;
+	LC_EntityIterator(const RS_EntityContainer& container, RS2::ResolveLevel level);
+
+	reference operator*() const {
+		return current;
+	}
+	LC_EntityIterator& operator++() {
+		advance();
+		return *this;
+	}
+	bool operator==(const LC_EntityIterator& rhs) const {
+		return current == rhs.current;
+	}
+	bool operator!=(const LC_EntityIterator& rhs) const {
+		return current != rhs.current;
+	}
+
+	/** @return true, if entities of the container are traversed for the level */
+	static bool isResolved(RS_Entity const* container, RS2::ResolveLevel level);
+
+private:
+	void push(const RS_EntityContainer& container);
+	void advance();
+
+	struct Frame {
+		QList<RS_Entity*>::const_iterator it;
+		QList<RS_Entity*>::const_iterator end;
+	};
+	std::vector<Frame> stack;
+	RS2::ResolveLevel level = RS2::ResolveNone;
+	RS_Entity* current = nullptr;
+};
+
+/**
+ * Range of entities for range based for loops and visitors, see
+ * RS_EntityContainer::deepEntities().
+ */
+class LC_EntityRange {
+public:
+	LC_EntityRange(const RS_EntityContainer& container, RS2::ResolveLevel level);
+
+	LC_EntityIterator begin() const;
+	LC_EntityIterator end() const;
+
+	/** calls visitor for each entity */
+	void forEach(const std::function<void(RS_Entity*)>& visitor) const;
+	/** @return all entities, e.g. to process them with LC_Parallel */
+	std::vector<RS_Entity*> toVector() const;
+
+private:
+	const RS_EntityContainer& container;
+	RS2::ResolveLevel level;
+};
+
+#endif // LC_ENTITYITERATOR_H
@@ -0,0 +1,76 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lc_parallel.h"
+
+unsigned LC_Parallel::threadCount()
+{
+	unsigned const n = std::thread::hardware_concurrency();
+	return std::max(n, 1u);
+}
+
+void LC_Parallel::forRange(std::size_t count,
+						   const std::function<void(std::size_t, std::size_t)>& func,
+						   std::size_t minChunk)
+{
+	if (count == 0)
+		return;
+
+	std::size_t const chunk = std::max<std::size_t>(minChunk, 1);
+	std::size_t const workers = std::min<std::size_t>(threadCount(),
+													  (count + chunk - 1) / chunk);
+	if (workers <= 1) {
+		func(0, count);
+		return;
+	}
+
+	// the calling thread takes the first range
+	std::size_t const step = (count + workers - 1) / workers;
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	auto run = [&](std::size_t begin, std::size_t end) {
+		try {
+			func(begin, end);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error)
+				error = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(workers - 1);
+	for (std::size_t begin = step; begin < count; begin += step)
+		threads.emplace_back(run, begin, std::min(begin + step, count));
+	run(0, std::min(step, count));
+
+	for (std::thread& t: threads)
+		t.join();
+
+	if (error)
+		std::rethrow_exception(error);
+}
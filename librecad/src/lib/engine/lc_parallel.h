@@ -0,0 +1,57 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_PARALLEL_H
+#define LC_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * Helpers to spread independent work items over worker threads.
+ *
+ * The work functions must not touch the GUI, the undo buffer or the
+ * iteration state of entity containers (firstEntity()/nextEntity()).
+ */
+namespace LC_Parallel {
+
+/**
+ * @brief threadCount number of worker threads used by forRange()
+ * @return at least 1
+ */
+unsigned threadCount();
+
+/**
+ * @brief forRange calls func(begin, end) for consecutive, non-overlapping
+ * ranges covering [0, count). Ranges are processed concurrently, the call
+ * blocks until all of them are done. An exception thrown by func is
+ * rethrown in the calling thread.
+ * @param count number of work items
+ * @param func work function for the range [begin, end)
+ * @param minChunk ranges are not split below this number of items
+ */
+void forRange(std::size_t count,
+			  const std::function<void(std::size_t, std::size_t)>& func,
+			  std::size_t minChunk = 1);
+
+}
+
+#endif // LC_PARALLEL_H
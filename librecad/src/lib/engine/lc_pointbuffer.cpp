@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include "lc_pointbuffer.h"
+
+std::size_t LC_PointBuffer::size() const
+{
+	return xs.size();
+}
+
+bool LC_PointBuffer::empty() const
+{
+	return xs.empty();
+}
+
+void LC_PointBuffer::clear()
+{
+	xs.clear();
+	ys.clear();
+}
+
+void LC_PointBuffer::reserve(std::size_t count)
+{
+	xs.reserve(count);
+	ys.reserve(count);
+}
+
+RS_Vector LC_PointBuffer::at(std::size_t i) const
+{
+	return {xs[i], ys[i]};
+}
+
+void LC_PointBuffer::appendLattice(const RS_Vector& origin, const RS_Vector& stepX,
+								   const RS_Vector& stepY, std::size_t countX, std::size_t countY)
+{
+	std::size_t const start = size();
+	xs.resize(start + countX*countY);
+	ys.resize(start + countX*countY);
+	double* x = xs.data() + start;
+	double* y = ys.data() + start;
+	for (std::size_t j = 0; j < countY; ++j) {
+		double const rowX = origin.x + j*stepY.x;
+		double const rowY = origin.y + j*stepY.y;
+		// multiples instead of sums, no drift along long rows
+		for (std::size_t i = 0; i < countX; ++i) {
+			x[i] = rowX + i*stepX.x;
+			y[i] = rowY + i*stepX.y;
+		}
+		x += countX;
+		y += countX;
+	}
+}
@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_POINTBUFFER_H
+#define LC_POINTBUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "rs_vector.h"
+
+/**
+ * 2D points stored as separate arrays of x and y coordinates.
+ *
+ * Use it for large point sets, where one RS_Vector (with z and the valid
+ * flag) per point wastes memory bandwidth. The fill loops run over
+ * contiguous doubles, which compilers vectorize.
+ */
+class LC_PointBuffer {
+public:
+	LC_PointBuffer() = default;
+
+	std::size_t size() const;
+	bool empty() const;
+	void clear();
+	void reserve(std::size_t count);
+	RS_Vector at(std::size_t i) const;
+
+	/**
+	 * @brief appendLattice appends origin + i*stepX + j*stepY, row by row
+	 * @param countX number of points in a row, i < countX
+	 * @param countY number of rows, j < countY
+	 */
+	void appendLattice(const RS_Vector& origin, const RS_Vector& stepX,
+					   const RS_Vector& stepY, std::size_t countX, std::size_t countY);
+
+private:
+	std::vector<double> xs;
+	std::vector<double> ys;
+};
+
+#endif // LC_POINTBUFFER_H
@@ -0,0 +1,644 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+
+#include "lc_polylineoffset.h"
+#include "lc_broadphase.h"
+#include "lc_rect.h"
+#include "rs_arc.h"
+#include "rs_math.h"
+#include "rs_polyline.h"
+
+namespace {
+
+bool isSegment(RS_Entity const* e)
+{
+	return e->rtti() == RS2::EntityLine || e->rtti() == RS2::EntityArc;
+}
+
+//! bulge of a line or an arc, as of a segment of RS_Polyline
+double bulgeOf(RS_Entity const* e)
+{
+	if (e->rtti() != RS2::EntityArc)
+		return 0.;
+	auto arc = static_cast<RS_Arc const*>(e);
+	return std::tan(0.25*arc->getAngleLength())*(arc->isReversed() ? -1. : 1.);
+}
+
+//! a line or an arc from a to b, like a segment of RS_Polyline
+struct Segment {
+	RS_Vector a;
+	RS_Vector b;
+	double bulge = 0.;
+
+	bool isArc() const {
+		return std::abs(bulge) > RS_TOLERANCE;
+	}
+};
+
+struct Arc {
+	RS_Vector center;
+	double radius = 0.;
+	double start = 0.;
+	//! positive: counter clockwise
+	double sweep = 0.;
+};
+
+using Splits = std::vector<std::pair<double, RS_Vector>>;
+
+RS_Vector unitOf(const RS_Vector& v)
+{
+	return v*(1./v.magnitude());
+}
+
+Arc arcOf(const Segment& s)
+{
+	RS_Vector const chord = s.b - s.a;
+	double const length = chord.magnitude();
+	RS_Vector const normal{-chord.y/length, chord.x/length};
+	Arc arc;
+	arc.sweep = 4.*std::atan(s.bulge);
+	arc.center = (s.a + s.b)*0.5 + normal*(0.25*length*(1. - s.bulge*s.bulge)/s.bulge);
+	arc.radius = arc.center.distanceTo(s.a);
+	arc.start = (s.a - arc.center).angle();
+	return arc;
+}
+
+double lengthOf(const Segment& s)
+{
+	if (!s.isArc())
+		return s.a.distanceTo(s.b);
+	Arc const arc = arcOf(s);
+	return arc.radius*std::abs(arc.sweep);
+}
+
+RS_Vector pointAt(const Segment& s, double t)
+{
+	if (!s.isArc())
+		return s.a + (s.b - s.a)*t;
+	Arc const arc = arcOf(s);
+	return arc.center + RS_Vector::polar(arc.radius, arc.start + arc.sweep*t);
+}
+
+RS_Vector tangentAt(const Segment& s, double t)
+{
+	if (!s.isArc())
+		return unitOf(s.b - s.a);
+	Arc const arc = arcOf(s);
+	return RS_Vector::polar(1., arc.start + arc.sweep*t + (arc.sweep > 0. ? M_PI_2 : -M_PI_2));
+}
+
+/** @return parameter of the point of s nearest to p, outside of [0, 1] beyond the ends */
+double paramOf(const Segment& s, const RS_Vector& p)
+{
+	if (!s.isArc()) {
+		RS_Vector const d = s.b - s.a;
+		return RS_Vector::dotP(p - s.a, d)/d.squared();
+	}
+	Arc const arc = arcOf(s);
+	double const angle = (p - arc.center).angle();
+	double const sweep = std::abs(arc.sweep);
+	double const delta = arc.sweep > 0. ? RS_Math::correctAngle(angle - arc.start)
+										: RS_Math::correctAngle(arc.start - angle);
+	// beyond the start rather than beyond the end
+	if (delta > M_PI + 0.5*sweep)
+		return (delta - 2.*M_PI)/sweep;
+	return delta/sweep;
+}
+
+Segment subSegment(const Segment& s, double t0, double t1, const RS_Vector& p0, const RS_Vector& p1)
+{
+	double const bulge = s.isArc() ? std::tan(std::atan(s.bulge)*(t1 - t0)) : 0.;
+	return {p0, p1, bulge};
+}
+
+LC_Rect boxOf(const Segment& s)
+{
+	RS_Vector minV = RS_Vector::minimum(s.a, s.b);
+	RS_Vector maxV = RS_Vector::maximum(s.a, s.b);
+	if (s.isArc()) {
+		Arc const arc = arcOf(s);
+		for (int i = 0; i < 4; ++i) {
+			RS_Vector const p = arc.center + RS_Vector::polar(arc.radius, i*M_PI_2);
+			double const t = paramOf(s, p);
+			if (t > 0. && t < 1.) {
+				minV = RS_Vector::minimum(minV, p);
+				maxV = RS_Vector::maximum(maxV, p);
+			}
+		}
+	}
+	return {minV, maxV};
+}
+
+double distanceTo(const Segment& s, const RS_Vector& p)
+{
+	double const t = paramOf(s, p);
+	if (t <= 0.)
+		return p.distanceTo(s.a);
+	if (t >= 1.)
+		return p.distanceTo(s.b);
+	if (!s.isArc())
+		return p.distanceTo(pointAt(s, t));
+	Arc const arc = arcOf(s);
+	return std::abs(p.distanceTo(arc.center) - arc.radius);
+}
+
+/** offsets s to the left, false if an arc collapses */
+bool offsetSegment(const Segment& s, double distance, double eps, Segment& result)
+{
+	if (!s.isArc()) {
+		RS_Vector const d = unitOf(s.b - s.a);
+		RS_Vector const normal{-d.y*distance, d.x*distance};
+		result = {s.a + normal, s.b + normal, 0.};
+		return true;
+	}
+	Arc const arc = arcOf(s);
+	double const radius = arc.radius - (arc.sweep > 0. ? distance : -distance);
+	if (radius <= eps)
+		return false;
+	double const f = radius/arc.radius;
+	result = {arc.center + (s.a - arc.center)*f, arc.center + (s.b - arc.center)*f, s.bulge};
+	return true;
+}
+
+/** intersections of the lines or circles of two segments */
+std::vector<RS_Vector> candidates(const Segment& s1, const Segment& s2, double eps)
+{
+	std::vector<RS_Vector> ret;
+	if (!s1.isArc() && !s2.isArc()) {
+		RS_Vector const d1 = s1.b - s1.a;
+		RS_Vector const d2 = s2.b - s2.a;
+		double const den = RS_Vector::crossP(d1, d2).z;
+		if (std::abs(den) > 1e-12*d1.magnitude()*d2.magnitude())
+			ret.push_back(s1.a + d1*(RS_Vector::crossP(s2.a - s1.a, d2).z/den));
+		return ret;
+	}
+	if (s1.isArc() != s2.isArc()) {
+		const Segment& line = s1.isArc() ? s2 : s1;
+		Arc const arc = arcOf(s1.isArc() ? s1 : s2);
+		RS_Vector const u = unitOf(line.b - line.a);
+		RS_Vector const f = line.a - arc.center;
+		double const b = RS_Vector::dotP(f, u);
+		double disc = b*b - f.squared() + arc.radius*arc.radius;
+		if (disc < -2.*eps*arc.radius)
+			return ret;
+		disc = std::sqrt(std::max(0., disc));
+		ret.push_back(line.a + u*(-b - disc));
+		if (disc > 0.)
+			ret.push_back(line.a + u*(-b + disc));
+		return ret;
+	}
+	Arc const arc1 = arcOf(s1);
+	Arc const arc2 = arcOf(s2);
+	RS_Vector const d = arc2.center - arc1.center;
+	double const dist = d.magnitude();
+	if (dist < eps || dist > arc1.radius + arc2.radius + eps
+			|| dist < std::abs(arc1.radius - arc2.radius) - eps)
+		return ret;
+	double const a = (arc1.radius*arc1.radius - arc2.radius*arc2.radius + dist*dist)/(2.*dist);
+	double const h = std::sqrt(std::max(0., arc1.radius*arc1.radius - a*a));
+	RS_Vector const middle = arc1.center + d*(a/dist);
+	RS_Vector const normal{-d.y/dist, d.x/dist};
+	ret.push_back(middle + normal*h);
+	if (h > 0.)
+		ret.push_back(middle - normal*h);
+	return ret;
+}
+
+bool isOverlapping(const Segment& s1, const Segment& s2, double eps)
+{
+	if (s1.isArc() != s2.isArc())
+		return false;
+	if (!s1.isArc()) {
+		RS_Vector const d1 = s1.b - s1.a;
+		return std::abs(RS_Vector::crossP(d1, s2.a - s1.a).z) <= eps*d1.magnitude()
+				&& std::abs(RS_Vector::crossP(d1, s2.b - s1.a).z) <= eps*d1.magnitude();
+	}
+	Arc const arc1 = arcOf(s1);
+	Arc const arc2 = arcOf(s2);
+	return arc1.center.distanceTo(arc2.center) <= eps && std::abs(arc1.radius - arc2.radius) <= eps;
+}
+
+/** adds the intersections in the interior of s1 or s2 to their splits */
+void intersect(const Segment& s1, const Segment& s2, double eps, Splits& splits1, Splits& splits2)
+{
+	double const e1 = eps/lengthOf(s1);
+	double const e2 = eps/lengthOf(s2);
+	auto addSplit = [](const Segment& s, double e, const RS_Vector& p, Splits& splits) {
+		double const t = paramOf(s, p);
+		if (t > e && t < 1. - e)
+			splits.emplace_back(t, p);
+	};
+	if (isOverlapping(s1, s2, eps)) {
+		for (const RS_Vector& p: {s2.a, s2.b})
+			addSplit(s1, e1, p, splits1);
+		for (const RS_Vector& p: {s1.a, s1.b})
+			addSplit(s2, e2, p, splits2);
+		return;
+	}
+	for (const RS_Vector& p: candidates(s1, s2, eps)) {
+		double const t1 = paramOf(s1, p);
+		double const t2 = paramOf(s2, p);
+		if (t1 < -e1 || t1 > 1. + e1 || t2 < -e2 || t2 > 1. + e2)
+			continue;
+		if (t1 > e1 && t1 < 1. - e1)
+			splits1.emplace_back(t1, p);
+		if (t2 > e2 && t2 < 1. - e2)
+			splits2.emplace_back(t2, p);
+	}
+}
+
+/** grid of segments for distance queries */
+class SegmentGrid {
+public:
+	SegmentGrid(const std::vector<Segment>& segments, double cellSize):
+		segments{segments}
+	{
+		boxes.reserve(segments.size());
+		for (const Segment& s: segments)
+			boxes.push_back(boxOf(s));
+		minV = boxes.front().minP();
+		RS_Vector maxV = boxes.front().maxP();
+		for (const LC_Rect& box: boxes) {
+			minV = RS_Vector::minimum(minV, box.minP());
+			maxV = RS_Vector::maximum(maxV, box.maxP());
+		}
+		// about one segment per cell, at most a few cells per query
+		double const width = maxV.x - minV.x;
+		double const height = maxV.y - minV.y;
+		double const count = segments.size();
+		cell = std::max({cellSize, std::sqrt(width*height/count),
+						 std::max(width, height)/(4.*count), RS_TOLERANCE});
+		nx = int((maxV.x - minV.x)/cell) + 1;
+		ny = int((maxV.y - minV.y)/cell) + 1;
+		cells.resize(size_t(nx)*ny);
+		for (unsigned i = 0; i < boxes.size(); ++i) {
+			for (int x = column(boxes[i].minP().x); x <= column(boxes[i].maxP().x); ++x)
+				for (int y = row(boxes[i].minP().y); y <= row(boxes[i].maxP().y); ++y)
+					cells[size_t(y)*nx + x].push_back(i);
+		}
+	}
+
+	/** @return true, if a segment is closer than limit to p */
+	bool isCloser(const RS_Vector& p, double limit) const {
+		for (int x = column(p.x - limit); x <= column(p.x + limit); ++x) {
+			for (int y = row(p.y - limit); y <= row(p.y + limit); ++y) {
+				for (unsigned i: cells[size_t(y)*nx + x]) {
+					if (distanceTo(segments[i], p) < limit)
+						return true;
+				}
+			}
+		}
+		return false;
+	}
+
+private:
+	int column(double x) const {
+		return std::max(0, std::min(nx - 1, int(std::floor((x - minV.x)/cell))));
+	}
+	int row(double y) const {
+		return std::max(0, std::min(ny - 1, int(std::floor((y - minV.y)/cell))));
+	}
+
+	const std::vector<Segment>& segments;
+	std::vector<LC_Rect> boxes;
+	std::vector<std::vector<unsigned>> cells;
+	RS_Vector minV;
+	double cell = 1.;
+	int nx = 1;
+	int ny = 1;
+};
+
+/**
+ * Joins the offsets of two segments meeting in vertex v. Convex corners are
+ * rounded by an arc around v, at concave corners the offsets overlap and
+ * the connecting line is removed with the overlapping parts later.
+ */
+void join(std::vector<Segment>& raw, const RS_Vector& from, const RS_Vector& to, const RS_Vector& v,
+		  const RS_Vector& tangentIn, const RS_Vector& tangentOut, double distance, double eps)
+{
+	if (from.distanceTo(to) <= eps)
+		return;
+	double const turn = RS_Vector::crossP(tangentIn, tangentOut).z;
+	bool const reversal = std::abs(turn) <= 1e-9 && RS_Vector::dotP(tangentIn, tangentOut) < 0.;
+	if (v.valid && (turn*distance < 0. || reversal)) {
+		RS_Vector const p = from - v;
+		RS_Vector const q = to - v;
+		double const sweep = reversal ? (distance > 0. ? -M_PI : M_PI)
+									  : std::atan2(RS_Vector::crossP(p, q).z, RS_Vector::dotP(p, q));
+		raw.push_back({from, to, std::tan(0.25*sweep)});
+	} else {
+		raw.push_back({from, to, 0.});
+	}
+}
+
+/** merges points closer than eps */
+class VertexTable {
+public:
+	explicit VertexTable(double eps):
+		eps{eps}
+	{}
+
+	unsigned id(const RS_Vector& p) {
+		long long const cx = std::llround(p.x/eps);
+		long long const cy = std::llround(p.y/eps);
+		for (long long x = cx - 1; x <= cx + 1; ++x) {
+			for (long long y = cy - 1; y <= cy + 1; ++y) {
+				auto it = cells.find({x, y});
+				if (it == cells.end())
+					continue;
+				for (unsigned i: it->second) {
+					if (vertices[i].squaredTo(p) <= eps*eps)
+						return i;
+				}
+			}
+		}
+		cells[{cx, cy}].push_back(vertices.size());
+		vertices.push_back(p);
+		return vertices.size() - 1;
+	}
+
+private:
+	double eps;
+	std::vector<RS_Vector> vertices;
+	std::map<std::pair<long long, long long>, std::vector<unsigned>> cells;
+};
+
+std::vector<Segment> segmentsOf(const LC_PolylineOffset::Path& path, double eps)
+{
+	std::vector<Segment> segments;
+	size_t const n = path.vertices.size();
+	size_t const count = path.closed ? n : n - 1;
+	for (size_t i = 0; n > 1 && i < count; ++i) {
+		Segment const s{path.vertices[i].first, path.vertices[(i + 1) % n].first,
+					path.vertices[i].second};
+		if (s.a.distanceTo(s.b) > eps)
+			segments.push_back(s);
+	}
+	return segments;
+}
+
+}
+
+LC_PolylineOffset::Path LC_PolylineOffset::fromPolyline(const RS_Polyline& polyline)
+{
+	Path path;
+	path.closed = polyline.isClosed();
+	RS_Entity const* last = nullptr;
+	for (RS_Entity* e: polyline) {
+		if (e->isUndone() || !isSegment(e))
+			continue;
+		path.vertices.emplace_back(e->getStartpoint(), bulgeOf(e));
+		last = e;
+	}
+	if (last && !path.closed)
+		path.vertices.emplace_back(last->getEndpoint(), 0.);
+	return path;
+}
+
+std::vector<LC_PolylineOffset::Chain> LC_PolylineOffset::chains(
+		const std::vector<RS_Entity const*>& entities, double tolerance)
+{
+	// endpoint 2*i is the start point of entity i, 2*i + 1 its end point
+	auto pointOf = [&entities](std::size_t node) {
+		RS_Entity const* e = entities[node/2];
+		return node%2 ? e->getEndpoint() : e->getStartpoint();
+	};
+	auto cellOf = [tolerance](const RS_Vector& p) {
+		return std::make_pair(static_cast<long long>(std::floor(p.x/tolerance)),
+							  static_cast<long long>(std::floor(p.y/tolerance)));
+	};
+	std::map<std::pair<long long, long long>, std::vector<std::size_t>> cells;
+	for (std::size_t i = 0; i < entities.size(); ++i) {
+		if (!isSegment(entities[i]))
+			continue;
+		cells[cellOf(pointOf(2*i))].push_back(2*i);
+		cells[cellOf(pointOf(2*i + 1))].push_back(2*i + 1);
+	}
+
+	// endpoints with exactly one other endpoint within tolerance
+	std::vector<std::ptrdiff_t> partner(2*entities.size(), -1);
+	for (auto const& cell: cells) {
+		for (std::size_t node: cell.second) {
+			RS_Vector const p = pointOf(node);
+			std::ptrdiff_t found = -1;
+			int count = 0;
+			for (long long dx = -1; dx <= 1; ++dx) {
+				for (long long dy = -1; dy <= 1; ++dy) {
+					auto it = cells.find({cell.first.first + dx, cell.first.second + dy});
+					if (it == cells.end())
+						continue;
+					for (std::size_t other: it->second) {
+						if (other/2 != node/2 && p.distanceTo(pointOf(other)) <= tolerance) {
+							found = static_cast<std::ptrdiff_t>(other);
+							++count;
+						}
+					}
+				}
+			}
+			if (count == 1)
+				partner[node] = found;
+		}
+	}
+	auto joined = [&partner](std::size_t node) -> std::ptrdiff_t {
+		std::ptrdiff_t const other = partner[node];
+		return other >= 0 && partner[static_cast<std::size_t>(other)] == static_cast<std::ptrdiff_t>(node)
+				? other : -1;
+	};
+
+	std::vector<Chain> ret;
+	std::vector<bool> visited(entities.size(), false);
+	for (std::size_t i = 0; i < entities.size(); ++i) {
+		if (visited[i] || !isSegment(entities[i]))
+			continue;
+		// walk backwards to the free endpoint of an open chain, a closed
+		// chain starts with entity i
+		std::size_t start = 2*i;
+		bool closed = false;
+		for (std::size_t steps = 0; steps < entities.size(); ++steps) {
+			std::ptrdiff_t const prev = joined(start);
+			if (prev < 0)
+				break;
+			if (static_cast<std::size_t>(prev)/2 == i) {
+				closed = true;
+				start = 2*i;
+				break;
+			}
+			start = static_cast<std::size_t>(prev) ^ 1;
+		}
+
+		Chain chain;
+		chain.path.closed = closed;
+		std::size_t node = start;
+		for (;;) {
+			std::size_t const k = node/2;
+			visited[k] = true;
+			chain.members.push_back(k);
+			// entered at the end point: the segment runs backwards
+			chain.path.vertices.emplace_back(pointOf(node), node%2 ? -bulgeOf(entities[k]) : bulgeOf(entities[k]));
+			std::ptrdiff_t const next = joined(node ^ 1);
+			if (next < 0 || visited[static_cast<std::size_t>(next)/2])
+				break;
+			node = static_cast<std::size_t>(next);
+		}
+		if (!closed)
+			chain.path.vertices.emplace_back(pointOf(node ^ 1), 0.);
+		if (chain.members.size() > 1)
+			ret.push_back(std::move(chain));
+	}
+	return ret;
+}
+
+double LC_PolylineOffset::side(const Path& path, const RS_Vector& coord)
+{
+	double minDistance = RS_MAXDOUBLE;
+	double ret = 1.;
+	for (const Segment& s: segmentsOf(path, RS_TOLERANCE)) {
+		double const distance = distanceTo(s, coord);
+		if (distance < minDistance) {
+			minDistance = distance;
+			double const t = std::max(0., std::min(1., paramOf(s, coord)));
+			ret = RS_Vector::crossP(tangentAt(s, t), coord - pointAt(s, t)).z >= 0. ? 1. : -1.;
+		}
+	}
+	return ret;
+}
+
+std::vector<LC_PolylineOffset::Path> LC_PolylineOffset::offset(const Path& path, double distance)
+{
+	RS_Vector minV{false};
+	RS_Vector maxV{false};
+	for (const auto& v: path.vertices) {
+		minV = minV.valid ? RS_Vector::minimum(minV, v.first) : v.first;
+		maxV = maxV.valid ? RS_Vector::maximum(maxV, v.first) : v.first;
+	}
+	if (!minV.valid)
+		return {};
+	double const eps = 1e-9*std::max({1., (maxV - minV).magnitude(), std::abs(distance)});
+	std::vector<Segment> const segments = segmentsOf(path, eps);
+	if (segments.empty())
+		return {};
+	if (std::abs(distance) <= eps)
+		return {path};
+
+	// raw offset, segment by segment
+	std::vector<Segment> raw;
+	int lastIndex = -1;
+	int firstIndex = -1;
+	for (size_t i = 0; i < segments.size(); ++i) {
+		Segment o;
+		if (!offsetSegment(segments[i], distance, eps, o))
+			continue;
+		if (lastIndex >= 0) {
+			bool const adjacent = lastIndex + 1 == int(i);
+			join(raw, raw.back().b, o.a, adjacent ? segments[i].a : RS_Vector{false},
+				 tangentAt(segments[lastIndex], 1.), tangentAt(segments[i], 0.), distance, eps);
+		} else {
+			firstIndex = i;
+		}
+		raw.push_back(o);
+		lastIndex = i;
+	}
+	if (raw.empty())
+		return {};
+	if (path.closed) {
+		bool const adjacent = firstIndex == 0 && lastIndex + 1 == int(segments.size());
+		join(raw, raw.back().b, raw.front().a, adjacent ? segments.front().a : RS_Vector{false},
+			 tangentAt(segments[lastIndex], 1.), tangentAt(segments[firstIndex], 0.), distance, eps);
+	}
+
+	// split at self-intersections
+	std::vector<LC_Rect> boxes;
+	boxes.reserve(raw.size());
+	for (const Segment& s: raw)
+		boxes.push_back(boxOf(s));
+	std::vector<Splits> splits(raw.size());
+	for (const auto& pair: LC_BroadPhase::overlappingPairs(boxes, eps))
+		intersect(raw[pair.first], raw[pair.second], eps, splits[pair.first], splits[pair.second]);
+
+	// keep the pieces at the offset distance from the path
+	SegmentGrid const grid{segments, std::abs(distance)};
+	double const limit = std::abs(distance) - 1e3*eps;
+	std::vector<std::vector<Segment>> chains;
+	bool connected = false;
+	for (size_t i = 0; i < raw.size(); ++i) {
+		Splits& s = splits[i];
+		std::sort(s.begin(), s.end(), [](const std::pair<double, RS_Vector>& a,
+									  const std::pair<double, RS_Vector>& b) {
+			return a.first < b.first;
+		});
+		s.emplace_back(1., raw[i].b);
+		double t0 = 0.;
+		RS_Vector p0 = raw[i].a;
+		for (const auto& split: s) {
+			if (split.second.distanceTo(p0) <= eps)
+				continue;
+			Segment const piece = subSegment(raw[i], t0, split.first, p0, split.second);
+			if (grid.isCloser(pointAt(piece, 0.5), limit)) {
+				connected = false;
+			} else {
+				if (!connected)
+					chains.emplace_back();
+				chains.back().push_back(piece);
+				connected = true;
+			}
+			t0 = split.first;
+			p0 = split.second;
+		}
+	}
+
+	// connect the chains across removed loops
+	VertexTable vertices{1e3*eps};
+	std::map<unsigned, size_t> starts;
+	for (size_t i = 0; i < chains.size(); ++i)
+		starts.emplace(vertices.id(chains[i].front().a), i);
+	std::vector<bool> consumed(chains.size(), false);
+	std::vector<Path> result;
+	for (size_t i = 0; i < chains.size(); ++i) {
+		if (consumed[i])
+			continue;
+		consumed[i] = true;
+		std::vector<Segment> chain = chains[i];
+		unsigned const start = vertices.id(chain.front().a);
+		starts.erase(start);
+		for (;;) {
+			auto it = starts.find(vertices.id(chain.back().b));
+			if (it == starts.end() || consumed[it->second])
+				break;
+			consumed[it->second] = true;
+			chain.insert(chain.end(), chains[it->second].begin(), chains[it->second].end());
+			starts.erase(it);
+		}
+
+		Path p;
+		p.closed = vertices.id(chain.back().b) == start;
+		for (const Segment& s: chain)
+			p.vertices.emplace_back(s.a, s.bulge);
+		if (!p.closed)
+			p.vertices.emplace_back(chain.back().b, 0.);
+		result.push_back(p);
+	}
+	return result;
+}
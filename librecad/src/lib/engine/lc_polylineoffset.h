@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_POLYLINEOFFSET_H
+#define LC_POLYLINEOFFSET_H
+
+#include <utility>
+#include <vector>
+
+#include "rs_vector.h"
+
+class RS_Entity;
+class RS_Polyline;
+
+/**
+ * Offset of polylines made of lines and arcs.
+ *
+ * The segments are offset one by one, convex corners are joined by arcs
+ * around the vertex. The raw offset is split at its self-intersections,
+ * found by a sweep over the segment boxes (LC_BroadPhase), and pieces
+ * closer to the polyline than the offset distance are removed. The
+ * remaining pieces are joined to the resulting polylines.
+ *
+ * Only plain geometry is involved, so offsets of different polylines or
+ * of different distances can be computed concurrently.
+ */
+class LC_PolylineOffset {
+public:
+	/** vertices with the bulge of the segment starting there, see RS_Polyline */
+	using Vertices = std::vector<std::pair<RS_Vector, double>>;
+
+	struct Path {
+		Vertices vertices;
+		bool closed = false;
+	};
+
+	//! connected lines and arcs, see chains()
+	struct Chain {
+		Path path;
+		//! indices of the entities of the chain
+		std::vector<std::size_t> members;
+	};
+
+	/** @return the vertices of a polyline of lines and arcs */
+	static Path fromPolyline(const RS_Polyline& polyline);
+
+	/**
+	 * @brief chains joins lines and arcs which share endpoints to paths,
+	 * like the segments of a polyline. Chains end at endpoints shared by
+	 * more than two entities.
+	 * @param entities lines and arcs, other entities are skipped
+	 * @param tolerance maximum distance of shared endpoints
+	 * @return chains of two or more entities
+	 */
+	static std::vector<Chain> chains(const std::vector<RS_Entity const*>& entities,
+									 double tolerance);
+
+	/**
+	 * @brief side direction to offset a path towards coord
+	 * @return 1 if coord is left of the nearest segment, else -1
+	 */
+	static double side(const Path& path, const RS_Vector& coord);
+
+	/**
+	 * @brief offset computes the offset of a path
+	 * @param distance positive: to the left of the path direction
+	 * @return resulting paths, empty if the path vanishes
+	 */
+	static std::vector<Path> offset(const Path& path, double distance);
+};
+
+#endif // LC_POLYLINEOFFSET_H
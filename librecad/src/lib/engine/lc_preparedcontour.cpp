@@ -0,0 +1,263 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "lc_preparedcontour.h"
+#include "lc_splinepoints.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_ellipse.h"
+#include "rs_entitycontainer.h"
+#include "rs_information.h"
+#include "rs_line.h"
+#include "rs_math.h"
+
+namespace {
+//! same as the tolerance of RS_Information::isPointInsideContour()
+constexpr double onContourTolerance = 1.0e-5;
+constexpr unsigned maxBuckets = 4096;
+}
+
+LC_PreparedContour::LC_PreparedContour(RS_EntityContainer const* contour):
+	minV{false}
+  ,maxV{false}
+{
+	if (!contour)
+		return;
+	for (RS_Entity* e: contour->deepEntities(RS2::ResolveAll)) {
+		if (!addEntity(e)) {
+			// isInside() tests the contour itself
+			exactContour = const_cast<RS_EntityContainer*>(contour);
+			edges.clear();
+			return;
+		}
+	}
+	buildBuckets();
+}
+
+LC_PreparedContour::LC_PreparedContour(const std::vector<std::vector<RS_Vector>>& loops):
+	minV{false}
+  ,maxV{false}
+{
+	for (const auto& loop: loops) {
+		for (size_t i = 0; i < loop.size(); ++i) {
+			addLine(loop[i], loop[(i + 1) % loop.size()]);
+			minV = minV.valid ? RS_Vector::minimum(minV, loop[i]) : loop[i];
+			maxV = maxV.valid ? RS_Vector::maximum(maxV, loop[i]) : loop[i];
+		}
+	}
+	buildBuckets();
+}
+
+bool LC_PreparedContour::addEntity(RS_Entity const* e)
+{
+	switch (e->rtti()) {
+	case RS2::EntityLine: {
+		auto line = static_cast<RS_Line const*>(e);
+		addLine(line->getStartpoint(), line->getEndpoint());
+		break;
+	}
+	case RS2::EntityArc: {
+		auto arc = static_cast<RS_Arc const*>(e);
+		double const r = arc->getRadius();
+		addCurve(arc->getCenter(), {r, 0.}, {0., r},
+				 arc->isReversed() ? arc->getAngle2() : arc->getAngle1(),
+				 arc->getAngleLength());
+		break;
+	}
+	case RS2::EntityCircle: {
+		auto circle = static_cast<RS_Circle const*>(e);
+		double const r = circle->getRadius();
+		addCurve(circle->getCenter(), {r, 0.}, {0., r}, 0., 2.*M_PI);
+		break;
+	}
+	case RS2::EntityEllipse: {
+		auto ellipse = static_cast<RS_Ellipse const*>(e);
+		RS_Vector const& major = ellipse->getMajorP();
+		RS_Vector const minor{-major.y*ellipse->getRatio(), major.x*ellipse->getRatio()};
+		addCurve(ellipse->getCenter(), major, minor,
+				 ellipse->isReversed() ? ellipse->getAngle2() : ellipse->getAngle1(),
+				 ellipse->getAngleLength());
+		break;
+	}
+	case RS2::EntitySplinePoints: {
+		// approximated by the same polyline that is drawn
+		auto spline = static_cast<LC_SplinePoints const*>(e);
+		std::vector<RS_Vector> const points = spline->getStrokePoints();
+		for (size_t i = 1; i < points.size(); ++i)
+			addLine(points[i - 1], points[i]);
+		if (spline->isClosed() && points.size() > 2)
+			addLine(points.back(), points.front());
+		break;
+	}
+	case RS2::EntityPoint:
+		return true;
+	default:
+		// splines are resolved into lines, other types aren't prepared
+		return false;
+	}
+	minV = minV.valid ? RS_Vector::minimum(minV, e->getMin()) : e->getMin();
+	maxV = maxV.valid ? RS_Vector::maximum(maxV, e->getMax()) : e->getMax();
+	return true;
+}
+
+void LC_PreparedContour::addLine(const RS_Vector& p1, const RS_Vector& p2)
+{
+	Edge edge;
+	edge.yMin = std::min(p1.y, p2.y);
+	edge.yMax = std::max(p1.y, p2.y);
+	edge.x1 = p1.x;
+	edge.y1 = p1.y;
+	// horizontal lines are never crossed, see isInside()
+	if (edge.yMax > edge.yMin)
+		edge.dxdy = (p2.x - p1.x)/(p2.y - p1.y);
+	edge.start = p1;
+	edge.end = p2;
+	edges.push_back(edge);
+}
+
+/**
+ * Splits the curve at the extrema of y. Between two extrema t - t0 is
+ * within [0, pi] or [pi, 2 pi], so t is unique for each y.
+ */
+void LC_PreparedContour::addCurve(const RS_Vector& center, const RS_Vector& major,
+								  const RS_Vector& minor, double start, double length)
+{
+	Edge edge;
+	edge.curve = true;
+	edge.center = center;
+	edge.major = major;
+	edge.minor = minor;
+	edge.t0 = std::atan2(minor.y, major.y);
+	edge.radiusY = std::hypot(major.y, minor.y);
+	// degenerated to a horizontal line
+	if (edge.radiusY < RS_TOLERANCE)
+		return;
+
+	auto yAt = [&edge](double t) {
+		return edge.center.y + edge.major.y*std::cos(t) + edge.minor.y*std::sin(t);
+	};
+	double const end = start + length;
+	double t = start;
+	while (t < end - RS_TOLERANCE_ANGLE) {
+		double const extremum = edge.t0 + M_PI*(std::floor((t - edge.t0)/M_PI + RS_TOLERANCE_ANGLE) + 1.);
+		double const next = std::min(extremum, end);
+		double const y1 = yAt(t);
+		double const y2 = yAt(next);
+		edge.yMin = std::min(y1, y2);
+		edge.yMax = std::max(y1, y2);
+		edge.falling = RS_Math::correctAngle(0.5*(t + next) - edge.t0) < M_PI;
+		edges.push_back(edge);
+		t = next;
+	}
+}
+
+void LC_PreparedContour::buildBuckets()
+{
+	if (edges.empty())
+		return;
+	unsigned const count = std::min<unsigned>(edges.size(), maxBuckets);
+	bucketHeight = (maxV.y - minV.y)/count;
+	if (bucketHeight <= 0.)
+		bucketHeight = 1.;
+
+	// counting sort of the edges into all buckets they overlap
+	bucketStart.assign(count + 1, 0);
+	for (const Edge& edge: edges) {
+		for (int i = bucketAt(edge.yMin), last = bucketAt(edge.yMax); i <= last; ++i)
+			++bucketStart[i + 1];
+	}
+	for (unsigned i = 0; i < count; ++i)
+		bucketStart[i + 1] += bucketStart[i];
+	bucketEdges.resize(bucketStart.back());
+	std::vector<unsigned> fill(bucketStart.begin(), bucketStart.end() - 1);
+	for (unsigned k = 0; k < edges.size(); ++k) {
+		for (int i = bucketAt(edges[k].yMin), last = bucketAt(edges[k].yMax); i <= last; ++i)
+			bucketEdges[fill[i]++] = k;
+	}
+}
+
+int LC_PreparedContour::bucketAt(double y) const
+{
+	int const last = int(bucketStart.size()) - 2;
+	int const i = int(std::floor((y - minV.y)/bucketHeight));
+	return std::max(0, std::min(i, last));
+}
+
+double LC_PreparedContour::xAt(const Edge& edge, double y)
+{
+	if (!edge.curve)
+		return edge.x1 + (y - edge.y1)*edge.dxdy;
+	double const c = std::max(-1., std::min(1., (y - edge.center.y)/edge.radiusY));
+	double const u = std::acos(c);
+	double const t = edge.falling ? edge.t0 + u : edge.t0 - u;
+	return edge.center.x + edge.major.x*std::cos(t) + edge.minor.x*std::sin(t);
+}
+
+bool LC_PreparedContour::isInside(const RS_Vector& point, bool* onContour) const
+{
+	if (exactContour)
+		return RS_Information::isPointInsideContour(point, exactContour, onContour);
+	if (onContour)
+		*onContour = false;
+	if (edges.empty()
+			|| point.x < minV.x || point.x > maxV.x
+			|| point.y < minV.y || point.y > maxV.y)
+		return false;
+
+	if (onContour) {
+		for (int i = bucketAt(point.y - onContourTolerance),
+			 last = bucketAt(point.y + onContourTolerance); i <= last && !*onContour; ++i) {
+			for (unsigned k = bucketStart[i]; k < bucketStart[i + 1]; ++k) {
+				const Edge& edge = edges[bucketEdges[k]];
+				if (point.y < edge.yMin - onContourTolerance
+						|| point.y > edge.yMax + onContourTolerance)
+					continue;
+				bool on = false;
+				if (!edge.curve && edge.yMax - edge.yMin < onContourTolerance) {
+					// horizontal line
+					on = point.x >= std::min(edge.start.x, edge.end.x) - onContourTolerance
+							&& point.x <= std::max(edge.start.x, edge.end.x) + onContourTolerance;
+				} else {
+					double const y = std::max(edge.yMin, std::min(edge.yMax, point.y));
+					on = std::abs(xAt(edge, y) - point.x) < onContourTolerance;
+				}
+				if (on) {
+					*onContour = true;
+					break;
+				}
+			}
+		}
+	}
+
+	// crossings of the ray from point to +x. Edges are half open in y, so a
+	// ray through a vertex counts only one of the edges meeting there.
+	bool inside = false;
+	int const i = bucketAt(point.y);
+	for (unsigned k = bucketStart[i]; k < bucketStart[i + 1]; ++k) {
+		const Edge& edge = edges[bucketEdges[k]];
+		if (point.y >= edge.yMin && point.y < edge.yMax && xAt(edge, point.y) > point.x)
+			inside = !inside;
+	}
+	return inside;
+}
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_PREPAREDCONTOUR_H
+#define LC_PREPAREDCONTOUR_H
+
+#include <vector>
+
+#include "rs_vector.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Contour prepared for repeated inside / outside tests, e.g. of the
+ * pieces of a hatch pattern.
+ *
+ * Lines, arcs, circles and ellipses of the contour are split into edges
+ * which are monotone in y; arcs and ellipses stay exact and are solved
+ * analytically. Spline point entities are approximated by the polylines
+ * they are drawn with, splines are resolved into their lines. The edges
+ * are sorted into buckets by y, so a query only visits the edges crossing
+ * the horizontal ray through the point. Points are inside by the even-odd
+ * rule, like islands of hatches.
+ *
+ * Contours with other entity types aren't prepared, isInside() falls back
+ * to RS_Information::isPointInsideContour() for them.
+ */
+class LC_PreparedContour {
+public:
+	/**
+	 * @param contour loops of lines, arcs, circles, ellipses and splines.
+	 * Sub containers are resolved, undone entities are skipped. The
+	 * contour must outlive this object.
+	 */
+	explicit LC_PreparedContour(RS_EntityContainer const* contour);
+	/**
+	 * @param loops closed polygons, the last vertex of a loop connects to
+	 * its first one
+	 */
+	explicit LC_PreparedContour(const std::vector<std::vector<RS_Vector>>& loops);
+
+	/**
+	 * @brief isInside whether point is inside of the contour
+	 * @param onContour set to true, if point is on the contour
+	 */
+	bool isInside(const RS_Vector& point, bool* onContour = nullptr) const;
+
+	bool isEmpty() const {
+		return edges.empty() && !exactContour;
+	}
+
+private:
+	//! an edge monotone in y
+	struct Edge {
+		double yMin = 0.;
+		double yMax = 0.;
+		bool curve = false;
+		//! line: x at y1 and dx/dy
+		double x1 = 0.;
+		double y1 = 0.;
+		double dxdy = 0.;
+		//! line endpoints, used for on contour tests of horizontal lines
+		RS_Vector start;
+		RS_Vector end;
+		//! curve: center + major*cos(t) + minor*sin(t)
+		RS_Vector center;
+		RS_Vector major;
+		RS_Vector minor;
+		//! y of the curve is center.y + radiusY*cos(t - t0)
+		double t0 = 0.;
+		double radiusY = 0.;
+		//! true: t - t0 within [0, pi], false: within [pi, 2 pi]
+		bool falling = true;
+	};
+
+	/** @return false if e can't be prepared */
+	bool addEntity(RS_Entity const* e);
+	void addLine(const RS_Vector& p1, const RS_Vector& p2);
+	void addCurve(const RS_Vector& center, const RS_Vector& major,
+				  const RS_Vector& minor, double start, double length);
+	void buildBuckets();
+	int bucketAt(double y) const;
+	static double xAt(const Edge& edge, double y);
+
+	std::vector<Edge> edges;
+	RS_Vector minV;
+	RS_Vector maxV;
+	//! edges of bucket i are bucketEdges[bucketStart[i], bucketStart[i+1])
+	std::vector<unsigned> bucketStart;
+	std::vector<unsigned> bucketEdges;
+	double bucketHeight = 0.;
+	//! set if the contour couldn't be prepared
+	RS_EntityContainer* exactContour = nullptr;
+};
+
+#endif // LC_PREPAREDCONTOUR_H
@@ -23,7 +23,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include<iostream>
 #include <QDebug>
 #include <cassert>
+#include <cmath>
 #include "lc_rect.h"
+#include "rs_math.h"
 
 #define INTERT_TEST(s) qDebug()<<"\ntesting " #s; \
 	assert(s); \
@@ -226,6 +228,68 @@ Area(coord, {coord.x + width, coord.y + height})
 				rhs.maxP().y + tolerance >= minP().y;
 	}
 
+	bool LC_Rect::intersectsSegment(const Coordinate& p1, const Coordinate& p2) const {
+		// clip the parameter range [t0, t1] of p1 + t (p2 - p1) by each border
+		double t0 = 0., t1 = 1.;
+		auto clip = [&t0, &t1](double p, double q) {
+			if (p == 0.)
+				return q >= 0.;
+			double const r = q / p;
+			if (p < 0.) {
+				if (r > t1)
+					return false;
+				t0 = std::max(t0, r);
+			} else {
+				if (r < t0)
+					return false;
+				t1 = std::min(t1, r);
+			}
+			return true;
+		};
+		Coordinate const d = p2 - p1;
+		return clip(-d.x, p1.x - _minP.x) && clip(d.x, _maxP.x - p1.x)
+				&& clip(-d.y, p1.y - _minP.y) && clip(d.y, _maxP.y - p1.y);
+	}
+
+	bool LC_Rect::intersectsEllipse(const Coordinate& center, const Coordinate& majorP,
+									double ratio, double angle1, double angle2,
+									bool reversed) const {
+		Coordinate const minorP{-majorP.y * ratio, majorP.x * ratio};
+		auto pointAt = [&](double t) {
+			return center + majorP * std::cos(t) + minorP * std::sin(t);
+		};
+		if (inArea(pointAt(angle1)) || inArea(pointAt(angle2)))
+			return true;
+
+		// otherwise the arc enters the area through a border: solve
+		// c + a cos(t) + b sin(t) = border for each border line
+		for (int axis = 0; axis < 2; ++axis) {
+			double const a = axis ? majorP.y : majorP.x;
+			double const b = axis ? minorP.y : minorP.x;
+			double const c = axis ? center.y : center.x;
+			double const r = std::hypot(a, b);
+			if (r < RS_TOLERANCE)
+				continue;
+			double const phi = std::atan2(b, a);
+			for (double border: {axis ? _minP.y : _minP.x, axis ? _maxP.y : _maxP.x}) {
+				double const k = (border - c) / r;
+				if (std::abs(k) > 1.)
+					continue;
+				double const dt = std::acos(k);
+				for (double t: {phi + dt, phi - dt}) {
+					if (!RS_Math::isAngleBetween(t, angle1, angle2, reversed))
+						continue;
+					Coordinate const p = pointAt(t);
+					double const v = axis ? p.x : p.y;
+					if (axis ? (v >= _minP.x - RS_TOLERANCE && v <= _maxP.x + RS_TOLERANCE)
+							 : (v >= _minP.y - RS_TOLERANCE && v <= _maxP.y + RS_TOLERANCE))
+						return true;
+				}
+			}
+		}
+		return false;
+	}
+
 	/**
 	 * @brief top
 	 * vector of this area
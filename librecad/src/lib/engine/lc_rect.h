@@ -161,6 +161,24 @@ public:
 	 */
 	bool intersects(Area const& rhs, double tolerance = 0.) const;
 
+	/**
+	 * @brief intersectsSegment whether any point of the line segment p1-p2
+	 * lies within this area (Liang-Barsky clipping)
+	 */
+	bool intersectsSegment(const Coordinate& p1, const Coordinate& p2) const;
+
+	/**
+	 * @brief intersectsEllipse whether any point of an elliptic arc lies
+	 * within this area
+	 * @param center, majorP, ratio the ellipse
+	 * @param angle1, angle2 parametric start and end angles of the arc, the
+	 * whole ellipse if both are equal
+	 * @param reversed the arc is clockwise from angle1 to angle2
+	 */
+	bool intersectsEllipse(const Coordinate& center, const Coordinate& majorP,
+						   double ratio, double angle1, double angle2,
+						   bool reversed = false) const;
+
 	/**
 		 * @brief top
 		 * vector of this area
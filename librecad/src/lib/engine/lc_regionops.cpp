@@ -0,0 +1,448 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "lc_regionops.h"
+#include "lc_broadphase.h"
+#include "lc_parallel.h"
+#include "lc_preparedcontour.h"
+#include "lc_rect.h"
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_debug.h"
+#include "rs_ellipse.h"
+#include "rs_hatch.h"
+#include "rs_line.h"
+#include "rs_math.h"
+#include "rs_polyline.h"
+
+namespace {
+
+//! number of chords approximating an arc of radius within tolerance
+int chordCount(double radius, double angleLength, double tolerance)
+{
+	if (radius <= tolerance)
+		return 1;
+	double const step = 2.*std::acos(1. - tolerance/radius);
+	int const n = int(std::ceil(angleLength/step));
+	// a full circle needs some vertices, a huge one not too many
+	return std::max(angleLength > M_PI ? 8 : 1, std::min(n, 16384));
+}
+
+/** @return vertices from start to end point of an entity of a contour */
+LC_RegionOps::Loop polygon(RS_Entity const* e, double tolerance)
+{
+	LC_RegionOps::Loop points;
+	switch (e->rtti()) {
+	case RS2::EntityLine:
+		points = {e->getStartpoint(), e->getEndpoint()};
+		break;
+	case RS2::EntityArc: {
+		auto arc = static_cast<RS_Arc const*>(e);
+		double const length = arc->getAngleLength();
+		double const sign = arc->isReversed() ? -1. : 1.;
+		int const n = chordCount(arc->getRadius(), length, tolerance);
+		for (int i = 0; i <= n; ++i) {
+			points.push_back(arc->getCenter()
+							 + RS_Vector::polar(arc->getRadius(), arc->getAngle1() + sign*length*i/n));
+		}
+		break;
+	}
+	case RS2::EntityCircle: {
+		auto circle = static_cast<RS_Circle const*>(e);
+		int const n = chordCount(circle->getRadius(), 2.*M_PI, tolerance);
+		for (int i = 0; i <= n; ++i)
+			points.push_back(circle->getCenter() + RS_Vector::polar(circle->getRadius(), 2.*M_PI*i/n));
+		break;
+	}
+	case RS2::EntityEllipse: {
+		auto ellipse = static_cast<RS_Ellipse const*>(e);
+		double const length = ellipse->getAngleLength();
+		double const sign = ellipse->isReversed() ? -1. : 1.;
+		int const n = chordCount(ellipse->getMajorRadius(), length, tolerance);
+		for (int i = 0; i <= n; ++i)
+			points.push_back(ellipse->getEllipsePoint(ellipse->getAngle1() + sign*length*i/n));
+		break;
+	}
+	default:
+		break;
+	}
+	return points;
+}
+
+/** @return loop of a chain of entities, empty, if an entity is not supported */
+LC_RegionOps::Loop chain(const RS_EntityContainer& container, double tolerance)
+{
+	LC_RegionOps::Loop loop;
+	bool firstOnly = true;
+	for (RS_Entity* e: container.deepEntities(RS2::ResolveAll)) {
+		LC_RegionOps::Loop points = polygon(e, tolerance);
+		if (points.empty())
+			return {};
+		// entities of hatch loops may have any direction
+		if (!loop.empty()) {
+			// the first one continues at the endpoint it shares with the second
+			if (firstOnly) {
+				double const front = std::min(loop.front().squaredTo(points.front()),
+											  loop.front().squaredTo(points.back()));
+				double const back = std::min(loop.back().squaredTo(points.front()),
+											 loop.back().squaredTo(points.back()));
+				if (front < back)
+					std::reverse(loop.begin(), loop.end());
+				firstOnly = false;
+			}
+			if (loop.back().squaredTo(points.back()) < loop.back().squaredTo(points.front()))
+				std::reverse(points.begin(), points.end());
+		}
+		loop.insert(loop.end(), points.begin() + (loop.empty() ? 0 : 1), points.end());
+	}
+	if (loop.size() > 1 && loop.front().distanceTo(loop.back()) < tolerance)
+		loop.pop_back();
+	if (loop.size() < 3)
+		return {};
+	return loop;
+}
+
+struct Segment {
+	RS_Vector a;
+	RS_Vector b;
+};
+
+using Splits = std::vector<std::pair<double, RS_Vector>>;
+
+/**
+ * Adds the intersection of two segments to their splits. Intersections
+ * close to an endpoint are moved onto the endpoint, so the pieces of both
+ * segments share the vertex.
+ */
+void intersect(const Segment& s1, const Segment& s2, double snap, Splits& splits1, Splits& splits2)
+{
+	RS_Vector const d1 = s1.b - s1.a;
+	RS_Vector const d2 = s2.b - s2.a;
+	RS_Vector const w = s2.a - s1.a;
+	double const l1 = d1.magnitude();
+	double const l2 = d2.magnitude();
+	double const et = snap/l1;
+	double const eu = snap/l2;
+	double const den = RS_Vector::crossP(d1, d2).z;
+
+	if (std::abs(den) > 1e-12*l1*l2) {
+		double const t = RS_Vector::crossP(w, d2).z/den;
+		double const u = RS_Vector::crossP(w, d1).z/den;
+		if (t < -et || t > 1. + et || u < -eu || u > 1. + eu)
+			return;
+		RS_Vector p = s1.a + d1*t;
+		if (u <= eu)
+			p = s2.a;
+		else if (u >= 1. - eu)
+			p = s2.b;
+		else if (t <= et)
+			p = s1.a;
+		else if (t >= 1. - et)
+			p = s1.b;
+		if (t > et && t < 1. - et)
+			splits1.emplace_back(t, p);
+		if (u > eu && u < 1. - eu)
+			splits2.emplace_back(u, p);
+		return;
+	}
+
+	// parallel, overlapping if collinear
+	if (std::abs(RS_Vector::crossP(d1, w).z) > snap*l1)
+		return;
+	for (const RS_Vector& q: {s2.a, s2.b}) {
+		double const t = RS_Vector::dotP(q - s1.a, d1)/(l1*l1);
+		if (t > et && t < 1. - et)
+			splits1.emplace_back(t, q);
+	}
+	for (const RS_Vector& q: {s1.a, s1.b}) {
+		double const u = RS_Vector::dotP(q - s2.a, d2)/(l2*l2);
+		if (u > eu && u < 1. - eu)
+			splits2.emplace_back(u, q);
+	}
+}
+
+/** merges vertices closer than snap */
+class VertexTable {
+public:
+	explicit VertexTable(double snap):
+		snap{snap}
+	{}
+
+	unsigned id(const RS_Vector& p) {
+		long long const cx = std::llround(p.x/snap);
+		long long const cy = std::llround(p.y/snap);
+		for (long long x = cx - 1; x <= cx + 1; ++x) {
+			for (long long y = cy - 1; y <= cy + 1; ++y) {
+				auto it = cells.find({x, y});
+				if (it == cells.end())
+					continue;
+				for (unsigned i: it->second) {
+					if (vertices[i].squaredTo(p) <= snap*snap)
+						return i;
+				}
+			}
+		}
+		cells[{cx, cy}].push_back(vertices.size());
+		vertices.push_back(p);
+		return vertices.size() - 1;
+	}
+
+	const RS_Vector& at(unsigned i) const {
+		return vertices[i];
+	}
+
+private:
+	double snap;
+	std::vector<RS_Vector> vertices;
+	std::map<std::pair<long long, long long>, std::vector<unsigned>> cells;
+};
+
+bool isInResult(LC_RegionOps::Operation operation, bool inSubject, bool inClip)
+{
+	switch (operation) {
+	case LC_RegionOps::Union:
+		return inSubject || inClip;
+	case LC_RegionOps::Intersection:
+		return inSubject && inClip;
+	case LC_RegionOps::Difference:
+		return inSubject && !inClip;
+	case LC_RegionOps::Xor:
+		return inSubject != inClip;
+	}
+	return false;
+}
+
+/** removes vertices in the middle of straight edges */
+LC_RegionOps::Loop simplify(const LC_RegionOps::Loop& loop, double snap)
+{
+	LC_RegionOps::Loop ret;
+	size_t const n = loop.size();
+	for (size_t i = 0; i < n; ++i) {
+		RS_Vector const& prev = loop[(i + n - 1) % n];
+		RS_Vector const& next = loop[(i + 1) % n];
+		RS_Vector const d1 = loop[i] - prev;
+		RS_Vector const d2 = next - loop[i];
+		if (std::abs(RS_Vector::crossP(d1, d2).z) <= snap*(next - prev).magnitude()
+				&& RS_Vector::dotP(d1, d2) > 0.)
+			continue;
+		ret.push_back(loop[i]);
+	}
+	return ret;
+}
+
+}
+
+LC_RegionOps::Loops LC_RegionOps::loops(RS_Entity const* entity, double tolerance)
+{
+	Loops ret;
+	if (!entity || tolerance <= 0.)
+		return ret;
+	switch (entity->rtti()) {
+	case RS2::EntityCircle:
+	case RS2::EntityEllipse: {
+		if (entity->rtti() == RS2::EntityEllipse
+				&& static_cast<RS_Ellipse const*>(entity)->getAngleLength() < 2.*M_PI - RS_TOLERANCE_ANGLE)
+			break;
+		Loop loop = polygon(entity, tolerance);
+		loop.pop_back();
+		ret.push_back(loop);
+		break;
+	}
+	case RS2::EntityPolyline: {
+		auto polyline = static_cast<RS_Polyline const*>(entity);
+		if (!polyline->isClosed()
+				&& polyline->getStartpoint().distanceTo(polyline->getEndpoint()) > tolerance)
+			break;
+		Loop loop = chain(*polyline, tolerance);
+		if (!loop.empty())
+			ret.push_back(loop);
+		break;
+	}
+	case RS2::EntityHatch:
+		for (RS_Entity* e: *static_cast<RS_Hatch const*>(entity)) {
+			// the hatch pattern is a temporary container
+			if (e->isUndone() || e->getFlag(RS2::FlagTemp) || e->rtti() != RS2::EntityContainer)
+				continue;
+			Loop loop = chain(*static_cast<RS_EntityContainer*>(e), tolerance);
+			if (!loop.empty())
+				ret.push_back(loop);
+		}
+		break;
+	default:
+		break;
+	}
+	return ret;
+}
+
+LC_RegionOps::Loops LC_RegionOps::combine(const Loops& subject, const Loops& clip, Operation operation)
+{
+	// edges of both operands
+	std::vector<Segment> segments;
+	RS_Vector minV{false};
+	RS_Vector maxV{false};
+	for (const Loops* loops: {&subject, &clip}) {
+		for (const Loop& loop: *loops) {
+			for (size_t i = 0; i < loop.size(); ++i) {
+				segments.push_back({loop[i], loop[(i + 1) % loop.size()]});
+				minV = minV.valid ? RS_Vector::minimum(minV, loop[i]) : loop[i];
+				maxV = maxV.valid ? RS_Vector::maximum(maxV, loop[i]) : loop[i];
+			}
+		}
+	}
+	if (segments.empty())
+		return {};
+	double const scale = std::max(1., (maxV - minV).magnitude());
+	double const snap = 1e-9*scale;
+	segments.erase(std::remove_if(segments.begin(), segments.end(), [snap](const Segment& s) {
+		return s.a.distanceTo(s.b) <= snap;
+	}), segments.end());
+
+	// split at all intersections
+	std::vector<LC_Rect> boxes;
+	boxes.reserve(segments.size());
+	for (const Segment& s: segments)
+		boxes.emplace_back(s.a, s.b);
+	std::vector<Splits> splits(segments.size());
+	for (const auto& pair: LC_BroadPhase::overlappingPairs(boxes, snap))
+		intersect(segments[pair.first], segments[pair.second], snap,
+				  splits[pair.first], splits[pair.second]);
+
+	// pieces between the splits, coincident pieces of both operands once
+	VertexTable vertices{snap};
+	std::vector<std::pair<unsigned, unsigned>> pieces;
+	std::set<std::pair<unsigned, unsigned>> known;
+	for (size_t i = 0; i < segments.size(); ++i) {
+		Splits& s = splits[i];
+		std::sort(s.begin(), s.end(), [](const std::pair<double, RS_Vector>& a,
+									  const std::pair<double, RS_Vector>& b) {
+			return a.first < b.first;
+		});
+		unsigned from = vertices.id(segments[i].a);
+		auto addPiece = [&](const RS_Vector& p) {
+			unsigned const to = vertices.id(p);
+			if (to == from)
+				return;
+			if (known.emplace(std::min(from, to), std::max(from, to)).second)
+				pieces.emplace_back(from, to);
+			from = to;
+		};
+		for (const auto& split: s)
+			addPiece(split.second);
+		addPiece(segments[i].b);
+	}
+
+	// keep the pieces between the result and its complement, inside on the left
+	LC_PreparedContour const subjectContour{subject};
+	LC_PreparedContour const clipContour{clip};
+	std::vector<signed char> direction(pieces.size(), 0);
+	LC_Parallel::forRange(pieces.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			RS_Vector const& a = vertices.at(pieces[i].first);
+			RS_Vector const& b = vertices.at(pieces[i].second);
+			double const length = a.distanceTo(b);
+			RS_Vector const middle = (a + b)*0.5;
+			RS_Vector const normal = RS_Vector{a.y - b.y, b.x - a.x}
+					*(std::min(0.25*length, 1e3*snap)/length);
+			bool const left = isInResult(operation, subjectContour.isInside(middle + normal),
+										 clipContour.isInside(middle + normal));
+			bool const right = isInResult(operation, subjectContour.isInside(middle - normal),
+										  clipContour.isInside(middle - normal));
+			if (left != right)
+				direction[i] = left ? 1 : -1;
+		}
+	}, 256);
+
+	std::vector<std::pair<unsigned, unsigned>> edges;
+	std::map<unsigned, std::vector<unsigned>> outgoing;
+	for (size_t i = 0; i < pieces.size(); ++i) {
+		if (!direction[i])
+			continue;
+		auto edge = pieces[i];
+		if (direction[i] < 0)
+			std::swap(edge.first, edge.second);
+		outgoing[edge.first].push_back(edges.size());
+		edges.push_back(edge);
+	}
+
+	// chain the edges, at shared vertices turn into the next edge
+	// clockwise, so loops touching in a vertex are separated
+	Loops result;
+	std::vector<bool> used(edges.size(), false);
+	for (size_t first = 0; first < edges.size(); ++first) {
+		if (used[first])
+			continue;
+		used[first] = true;
+		Loop loop{vertices.at(edges[first].first)};
+		unsigned current = first;
+		bool closed = true;
+		while (edges[current].second != edges[first].first) {
+			unsigned const v = edges[current].second;
+			RS_Vector const& p = vertices.at(v);
+			loop.push_back(p);
+			double const back = (vertices.at(edges[current].first) - p).angle();
+			int next = -1;
+			double minTurn = 0.;
+			for (unsigned candidate: outgoing[v]) {
+				if (used[candidate])
+					continue;
+				double const turn = RS_Math::correctAngle(back - (vertices.at(edges[candidate].second) - p).angle());
+				double const clockwise = turn > 0. ? turn : 2.*M_PI;
+				if (next < 0 || clockwise < minTurn) {
+					next = candidate;
+					minTurn = clockwise;
+				}
+			}
+			if (next < 0) {
+				closed = false;
+				break;
+			}
+			used[next] = true;
+			current = next;
+		}
+		if (!closed) {
+			RS_DEBUG->print(RS_Debug::D_WARNING, "LC_RegionOps::combine: open chain dropped");
+			continue;
+		}
+		loop = simplify(loop, snap);
+		if (loop.size() >= 3)
+			result.push_back(loop);
+	}
+	return result;
+}
+
+double LC_RegionOps::area(const Loops& region)
+{
+	double ret = 0.;
+	for (const Loop& loop: region) {
+		for (size_t i = 0; i < loop.size(); ++i) {
+			RS_Vector const& p = loop[i];
+			RS_Vector const& q = loop[(i + 1) % loop.size()];
+			ret += p.x*q.y - q.x*p.y;
+		}
+	}
+	return 0.5*ret;
+}
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_REGIONOPS_H
+#define LC_REGIONOPS_H
+
+#include <vector>
+
+#include "rs_vector.h"
+
+class RS_Entity;
+
+/**
+ * Boolean operations on regions bounded by closed contours.
+ *
+ * Regions are given as loops of vertices, arcs and ellipses are
+ * approximated by polygons within a tolerance. Inside is defined by the
+ * even-odd rule, so holes are loops inside of other loops.
+ *
+ * The edges of both operands are split at all their intersections, found
+ * with LC_BroadPhase. Each piece is kept, if the result of the operation
+ * differs on its two sides, and the kept pieces are chained into loops.
+ */
+class LC_RegionOps {
+public:
+	enum Operation {
+		Union,
+		Intersection,
+		Difference,	//!< subject minus clip
+		Xor
+	};
+
+	using Loop = std::vector<RS_Vector>;
+	using Loops = std::vector<Loop>;
+
+	/**
+	 * @brief loops the closed contours of an entity: closed polylines,
+	 * circles, full ellipses and the loops of hatches
+	 * @param tolerance maximum distance of the polygon to arcs and ellipses
+	 * @return empty, if the entity is not a closed contour
+	 */
+	static Loops loops(RS_Entity const* entity, double tolerance);
+
+	/**
+	 * @brief combine computes a boolean operation of two regions
+	 * @return loops of the result, outer loops counter clockwise and holes
+	 * clockwise
+	 */
+	static Loops combine(const Loops& subject, const Loops& clip, Operation operation);
+
+	/** @return area of a region, i.e. of a result of combine() */
+	static double area(const Loops& region);
+};
+
+
+/**
+ * Holds the data needed for boolean operations on regions, see
+ * RS_Modification::combineRegions().
+ */
+class RS_RegionData {
+public:
+	LC_RegionOps::Operation operation;
+	//! first operand, the selected contours are the other operands
+	RS_Entity* subject;
+	//! maximum distance of the result to arcs and ellipses
+	double tolerance;
+};
+
+#endif // LC_REGIONOPS_H
@@ -114,7 +114,9 @@ public:
         FormatLFF,           /**< LibreCAD Font File format. */
         FormatCXF,           /**< CAM Expert Font format. */
         FormatJWW,           /**< JWW Format type */
-        FormatJWC            /**< JWC Format type */
+        FormatJWC,           /**< JWC Format type */
+        FormatDXFRWBinary,   /**< Binary DXF format. v2007. */
+        FormatSnapshot       /**< LibreCAD snapshot, see LC_FilterSnapshot */
     };
 
     /**
@@ -1111,6 +1111,16 @@ double RS_Arc::getLength() const {
 
 
 
+bool RS_Arc::isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const {
+	LC_Rect const window{v1, v2};
+	if (!window.intersects(LC_Rect{getMin(), getMax()}))
+		return false;
+	return window.intersectsEllipse(data.center, {data.radius, 0.}, 1.,
+									data.angle1, data.angle2, data.reversed);
+}
+
+
+
 /**
  * Gets the arc's bulge (tangens of angle length divided by 4).
  */
@@ -182,6 +182,7 @@ public:
     double getAngleLength() const;
 	double getLength() const override;
     double getBulge() const;
+	bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const override;
 
     bool createFrom3P(const RS_Vector& p1, const RS_Vector& p2,
                       const RS_Vector& p3);
@@ -24,11 +24,14 @@
 **
 **********************************************************************/
 
+#include<algorithm>
+#include<cstdint>
 #include<iostream>
 #include "rs_block.h"
 
 #include "rs_graphic.h"
 #include "rs_insert.h"
+#include "rs_debug.h"
 
 RS_BlockData::RS_BlockData(const QString& _name,
 						   const RS_Vector& _basePoint,
@@ -61,6 +64,9 @@ RS_Entity* RS_Block::clone() const {
     blk->setOwner(isOwner());
     blk->detach();
     blk->initId();
+    blk->dependenciesValid = false;
+    blk->nestedInsertsValid = false;
+    blk->dependencyStampValid = false;
     return blk;
 }
 
@@ -195,6 +201,87 @@ QStringList RS_Block::findNestedInsert(const QString& bName) {
     return bnChain;
 }
 
+const std::vector<RS_Block*>& RS_Block::getDependencies() {
+	if (dependenciesValid && dependenciesGeneration == getGeneration())
+		return dependencies;
+
+	dependencies.clear();
+	collectDependencies(this);
+	dependenciesValid = true;
+	dependenciesGeneration = getGeneration();
+	return dependencies;
+}
+
+void RS_Block::collectDependencies(RS_EntityContainer const* container) {
+	for (RS_Entity* e: *container) {
+		if (e->rtti() == RS2::EntityInsert) {
+			RS_Block* blk = static_cast<RS_Insert*>(e)->getBlockForInsert();
+			if (blk && blk != this
+					&& std::find(dependencies.begin(), dependencies.end(), blk) == dependencies.end())
+				dependencies.push_back(blk);
+		} else if (e->isContainer() && e->rtti() != RS2::EntityHatch) {
+			collectDependencies(static_cast<RS_EntityContainer*>(e));
+		}
+	}
+}
+
+unsigned long long RS_Block::getDependencyStamp() {
+	// every change of a block changes the generation of its parent, the
+	// graphic, so the stamp is valid until the graphic changes
+	RS_EntityContainer const* const owner = getParent();
+	if (dependencyStampValid && owner && dependencyStampGeneration == owner->getGeneration())
+		return dependencyStamp;
+
+	// mix generation and identity of this block with the stamps of the
+	// blocks it inserts, so adding or removing a nested block changes the
+	// stamp as well
+	unsigned long long stamp = 1469598103934665603ULL;
+	stamp = (stamp ^ reinterpret_cast<std::uintptr_t>(this)) * 1099511628211ULL;
+	stamp = (stamp ^ getGeneration()) * 1099511628211ULL;
+	const std::vector<RS_Block*>& deps = getDependencies();
+	if (deps.empty())
+		return stamp;
+
+	// recursive block references are invalid, but must not hang
+	if (computingDependencyStamp)
+		return stamp;
+	computingDependencyStamp = true;
+	bool cacheable = owner != nullptr;
+	for (RS_Block* dep: deps) {
+		stamp = (stamp ^ dep->getDependencyStamp()) * 1099511628211ULL;
+		// blocks of other block lists don't change the generation of owner
+		cacheable = cacheable && dep->getParent() == owner;
+	}
+	computingDependencyStamp = false;
+
+	if (cacheable) {
+		dependencyStamp = stamp;
+		dependencyStampGeneration = owner->getGeneration();
+		dependencyStampValid = true;
+	}
+	return stamp;
+}
+
+void RS_Block::updateNestedInserts() {
+	// recursive block references are invalid, but must not hang
+	if (updatingNestedInserts
+			|| (nestedInsertsValid && nestedInsertsStamp == getDependencyStamp()))
+		return;
+	updatingNestedInserts = true;
+
+	RS_DEBUG->print("RS_Block::updateNestedInserts: %s", data.name.toLatin1().data());
+	// blocks inserted by this one are up to date before their inserts are
+	// regenerated from them
+	for (RS_Block* blk: getDependencies())
+		blk->updateNestedInserts();
+	updateInserts();
+
+	// updating the inserts changed the generation of this block
+	nestedInsertsStamp = getDependencyStamp();
+	nestedInsertsValid = true;
+	updatingNestedInserts = false;
+}
+
 std::ostream& operator << (std::ostream& os, const RS_Block& b) {
     os << " name: " << b.getName().toLatin1().data() << "\n";
     os << " entities: " << (RS_EntityContainer&)b << "\n";
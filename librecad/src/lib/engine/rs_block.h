@@ -28,6 +28,7 @@
 #ifndef RS_BLOCK_H
 #define RS_BLOCK_H
 
+#include <vector>
 #include "rs_document.h"
 
 /**
@@ -146,6 +147,7 @@ public:
 	 */
     void setName(const QString& n) {
 		data.name = n;
+		bumpGeneration();
     }
     
 	/**
@@ -162,6 +164,7 @@ public:
      */
     void toggle() {
 		data.frozen = !data.frozen;
+		bumpVisibilitySerial();
     }
 
     /**
@@ -171,6 +174,7 @@ public:
      */
     void freeze(bool freeze) {
 		data.frozen = freeze;
+		bumpVisibilitySerial();
     }
 	
     /**
@@ -219,9 +223,48 @@ public:
      */
     QStringList findNestedInsert(const QString& bName);
 
+	/**
+	 * @return Blocks inserted directly by this block, without duplicates.
+	 * The list is cached until the content of this block changes.
+	 */
+	const std::vector<RS_Block*>& getDependencies();
+
+	/**
+	 * @return Stamp combining the change generations of this block and of all
+	 * blocks it inserts, directly or nested. The stamp changes whenever one
+	 * of these blocks is edited. It is cached until the generation of the
+	 * parent graphic changes, which every block edit propagates to. Call it
+	 * once before inserts are updated concurrently to fill the cache.
+	 */
+	unsigned long long getDependencyStamp();
+
+	/**
+	 * Updates the inserts contained in this block. Nothing is done if
+	 * neither this block nor one of its nested blocks changed since the
+	 * last call.
+	 */
+	void updateNestedInserts();
+
 protected:
 	//! Block data
 	RS_BlockData data;
+
+private:
+	void collectDependencies(RS_EntityContainer const* container);
+
+	//! blocks inserted directly by this block
+	std::vector<RS_Block*> dependencies;
+	bool dependenciesValid = false;
+	unsigned long long dependenciesGeneration = 0;
+	//! dependency stamp of the last updateNestedInserts()
+	bool nestedInsertsValid = false;
+	unsigned long long nestedInsertsStamp = 0;
+	bool updatingNestedInserts = false;
+	//! cached getDependencyStamp(), valid for one generation of the parent
+	bool dependencyStampValid = false;
+	unsigned long long dependencyStampGeneration = 0;
+	unsigned long long dependencyStamp = 0;
+	bool computingDependencyStamp = false;
 };
 
 
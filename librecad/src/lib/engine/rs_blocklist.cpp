@@ -279,6 +279,38 @@ void RS_BlockList::toggle(RS_Block* block) {
 	}
 }
 
+/**
+ * @return All blocks ordered such that each block comes after the blocks
+ * it inserts (topological order of the block dependency graph).
+ * Recursive references are broken arbitrarily.
+ */
+std::vector<RS_Block*> RS_BlockList::sortedByDependency() const {
+	std::vector<RS_Block*> sorted;
+	sorted.reserve(blocks.size());
+	std::set<RS_Block*> visited;
+	// iterative depth first search, blocks are emitted after their dependencies
+	std::vector<std::pair<RS_Block*, size_t>> stack;
+	for (RS_Block* root: blocks) {
+		if (!visited.insert(root).second)
+			continue;
+		stack.emplace_back(root, 0);
+		while (!stack.empty()) {
+			RS_Block* blk = stack.back().first;
+			size_t& next = stack.back().second;
+			const std::vector<RS_Block*>& deps = blk->getDependencies();
+			if (next < deps.size()) {
+				RS_Block* dep = deps[next++];
+				if (visited.insert(dep).second)
+					stack.emplace_back(dep, 0);
+			} else {
+				sorted.push_back(blk);
+				stack.pop_back();
+			}
+		}
+	}
+	return sorted;
+}
+
 /**
  * Freezes or defreezes all blocks.
  *
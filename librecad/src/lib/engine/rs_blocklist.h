@@ -29,6 +29,7 @@
 #define RS_BLOCKLIST_H
 
 
+#include <vector>
 #include <QList>
 
 class QString;
@@ -80,6 +81,7 @@ public:
     void toggle(const QString& name);
     void toggle(RS_Block* block);
     void freezeAll(bool freeze);
+	std::vector<RS_Block*> sortedByDependency() const;
 
     void addListener(RS_BlockListListener* listener);
     void removeListener(RS_BlockListListener* listener);
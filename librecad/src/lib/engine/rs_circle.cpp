@@ -40,6 +40,7 @@
 #include "rs_math.h"
 #include "lc_hyperbola.h"
 #include "lc_quadratic.h"
+#include "lc_rect.h"
 #include "rs_debug.h"
 
 RS_CircleData::RS_CircleData(RS_Vector const& center, double radius):
@@ -124,6 +125,13 @@ double RS_Circle::getLength() const {
 	return 2*M_PI*data.radius;
 }
 
+bool RS_Circle::isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const {
+	LC_Rect const window{v1, v2};
+	if (!window.intersects(LC_Rect{getMin(), getMax()}))
+		return false;
+	return window.intersectsEllipse(data.center, {data.radius, 0.}, 1., 0., 0.);
+}
+
 bool RS_Circle::isTangent(const RS_CircleData&  circleData) const{
 	const double d=circleData.center.distanceTo(data.center);
 //    DEBUG_HEADER
@@ -106,6 +106,7 @@ public:
 	void setRadius(double r);
     double getAngleLength() const;
 	double getLength() const override;
+	bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const override;
 	bool isTangent(const RS_CircleData&  circleData) const override;
 
     bool createFromCR(const RS_Vector& c, double r);
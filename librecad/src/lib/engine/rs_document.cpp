@@ -26,6 +26,8 @@
 **********************************************************************/
 
 
+#include <algorithm>
+
 #include "rs_document.h"
 #include "rs_debug.h"
 
@@ -51,6 +53,249 @@ RS_Document::RS_Document(RS_EntityContainer* parent)
     gv = NULL;//used to read/save current view
 }
 
+/**
+ * The deep count of all selected entities is cached, other counts are
+ * passed on to RS_EntityContainer.
+ */
+unsigned RS_Document::countSelected(bool deep, std::initializer_list<RS2::EntityType> const& types)
+{
+	if (!deep || types.size())
+		return RS_EntityContainer::countSelected(deep, types);
+	if (!isSelectionTallyValid())
+		updateSelectionTally();
+	return selectionTally.count;
+}
+
+double RS_Document::totalSelectedLength()
+{
+	if (!isSelectionTallyValid())
+		updateSelectionTally();
+	return selectionTally.length;
+}
+
+unsigned RS_Document::selectEntities(const std::vector<RS_Entity*>& entities, bool select)
+{
+	bool const valid = isSelectionTallyValid();
+	long long countDelta = 0;
+	double lengthDelta = 0.;
+	unsigned changed = changeSelection(entities, select, countDelta, lengthDelta);
+	if (valid) {
+		selectionTally.count += countDelta;
+		selectionTally.length = selectionTally.count ? selectionTally.length + lengthDelta : 0.;
+		selectionTally.generation = getGeneration();
+		selectionTally.serial = selectionSerial.count;
+		selectionTally.visibility = RS_Entity::visibilitySerial();
+	}
+	return changed;
+}
+
+std::vector<RS_Entity*> RS_Document::selectedEntities()
+{
+	if (!selectionSet.valid)
+		updateSelectionSet();
+#ifdef QT_DEBUG
+	checkSelection();
+#endif
+	// a copy: callers usually change the selection while iterating
+	std::vector<RS_Entity*> ret;
+	ret.reserve(selectionSet.entities.size());
+	for (RS_Entity* e: selectionSet.entities) {
+		// hidden by a frozen layer or undone
+		if (e->isSelected())
+			ret.push_back(e);
+	}
+	std::sort(ret.begin(), ret.end(), [this](RS_Entity const* a, RS_Entity const* b) {
+		return selectionSet.order.at(a) < selectionSet.order.at(b);
+	});
+	return ret;
+}
+
+void RS_Document::selectionChanged(RS_Entity* entity, bool selected)
+{
+	// entities which are not in the entity list yet are added on insertion
+	if (!selectionSet.valid || !selectionSet.order.count(entity))
+		return;
+	if (selected)
+		selectionSet.entities.insert(entity);
+	else
+		selectionSet.entities.erase(entity);
+}
+
+void RS_Document::addEntity(RS_Entity* entity)
+{
+	RS_EntityContainer::addEntity(entity);
+	// images and hatches are prepended
+	if (entity && !entities.isEmpty())
+		addToSelectionSet(entity, entities.first() == entity ? 0 : entities.size() - 1);
+}
+
+void RS_Document::appendEntity(RS_Entity* entity)
+{
+	RS_EntityContainer::appendEntity(entity);
+	addToSelectionSet(entity, entities.size() - 1);
+}
+
+void RS_Document::prependEntity(RS_Entity* entity)
+{
+	RS_EntityContainer::prependEntity(entity);
+	addToSelectionSet(entity, 0);
+}
+
+void RS_Document::moveEntity(int index, QList<RS_Entity *>& entList)
+{
+	RS_EntityContainer::moveEntity(index, entList);
+	// changes the order of many entities, rebuilt on the next query
+	selectionSet.valid = false;
+}
+
+void RS_Document::insertEntity(int index, RS_Entity* entity)
+{
+	RS_EntityContainer::insertEntity(index, entity);
+	addToSelectionSet(entity, index);
+}
+
+bool RS_Document::removeEntity(RS_Entity* entity)
+{
+	// before the entity is deleted by RS_EntityContainer
+	if (selectionSet.valid && entity && selectionSet.order.count(entity)) {
+		selectionSet.entities.erase(entity);
+		selectionSet.order.erase(entity);
+	}
+	return RS_EntityContainer::removeEntity(entity);
+}
+
+void RS_Document::clear()
+{
+	RS_EntityContainer::clear();
+	selectionSet.valid = false;
+	selectionSet.entities.clear();
+	selectionSet.order.clear();
+}
+
+void RS_Document::detach()
+{
+	RS_EntityContainer::detach();
+	// the entities are replaced by copies
+	selectionSet.valid = false;
+	selectionSet.entities.clear();
+	selectionSet.order.clear();
+}
+
+/**
+ * Adds an entity, which was just added to the entity list at the given
+ * index, to the selection set. The order key lies between the keys of its
+ * neighbors.
+ */
+void RS_Document::addToSelectionSet(RS_Entity* entity, int index)
+{
+	if (!selectionSet.valid || !entity)
+		return;
+	if (index < 0 || index >= entities.size() || entities.at(index) != entity) {
+		selectionSet.valid = false;
+		return;
+	}
+
+	double key = 0.;
+	if (entities.size() == 1) {
+		selectionSet.first = selectionSet.last = key;
+	} else if (index + 1 == entities.size()) {
+		key = selectionSet.last += 1.;
+	} else if (index == 0) {
+		key = selectionSet.first -= 1.;
+	} else {
+		auto const prev = selectionSet.order.find(entities.at(index - 1));
+		auto const next = selectionSet.order.find(entities.at(index + 1));
+		if (prev == selectionSet.order.end() || next == selectionSet.order.end()) {
+			selectionSet.valid = false;
+			return;
+		}
+		key = 0.5 * (prev->second + next->second);
+		// no room left between the neighbors, renumber on the next query
+		if (!(prev->second < key && key < next->second)) {
+			selectionSet.valid = false;
+			return;
+		}
+	}
+	selectionSet.order[entity] = key;
+	if (entity->getFlag(RS2::FlagSelected))
+		selectionSet.entities.insert(entity);
+}
+
+bool RS_Document::checkSelection()
+{
+	if (!selectionSet.valid)
+		return true;
+	bool consistent = true;
+	size_t selected = 0;
+	double previous = -RS_MAXDOUBLE;
+	for (auto e: entities) {
+		if (!e)
+			continue;
+		auto const it = selectionSet.order.find(e);
+		if (it == selectionSet.order.end() || it->second <= previous) {
+			RS_DEBUG->print(RS_Debug::D_WARNING,
+							"RS_Document::checkSelection: entity %lu is out of order",
+							e->getId());
+			consistent = false;
+		} else {
+			previous = it->second;
+		}
+		if (!e->getFlag(RS2::FlagSelected))
+			continue;
+		++selected;
+		if (!selectionSet.entities.count(e)) {
+			RS_DEBUG->print(RS_Debug::D_WARNING,
+							"RS_Document::checkSelection: entity %lu is not in the selection",
+							e->getId());
+			consistent = false;
+		}
+	}
+	if (selected != selectionSet.entities.size()) {
+		RS_DEBUG->print(RS_Debug::D_WARNING,
+						"RS_Document::checkSelection: %u selected entities, %u in the selection",
+						unsigned(selected), unsigned(selectionSet.entities.size()));
+		consistent = false;
+	}
+	return consistent;
+}
+
+void RS_Document::updateSelectionSet()
+{
+	selectionSet.entities.clear();
+	selectionSet.order.clear();
+	selectionSet.order.reserve(entities.size());
+	double key = 0.;
+	for (auto e: entities) {
+		if (!e)
+			continue;
+		selectionSet.order[e] = key;
+		key += 1.;
+		if (e->getFlag(RS2::FlagSelected))
+			selectionSet.entities.insert(e);
+	}
+	selectionSet.first = 0.;
+	selectionSet.last = key - 1.;
+	selectionSet.valid = true;
+}
+
+bool RS_Document::isSelectionTallyValid() const
+{
+	return selectionTally.valid
+			&& selectionTally.generation == getGeneration()
+			&& selectionTally.serial == selectionSerial.count
+			&& selectionTally.visibility == RS_Entity::visibilitySerial();
+}
+
+void RS_Document::updateSelectionTally()
+{
+	selectionTally.count = RS_EntityContainer::countSelected();
+	selectionTally.length = RS_EntityContainer::totalSelectedLength();
+	selectionTally.generation = getGeneration();
+	selectionTally.serial = selectionSerial.count;
+	selectionTally.visibility = RS_Entity::visibilitySerial();
+	selectionTally.valid = true;
+}
+
 /**
  * Overwritten to set modified flag when undo cycle finished with undoable(s).
  */
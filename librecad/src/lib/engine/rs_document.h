@@ -29,6 +29,9 @@
 #ifndef RS_DOCUMENT_H
 #define RS_DOCUMENT_H
 
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 #include "rs_layerlist.h"
 #include "rs_entitycontainer.h"
 #include "rs_undo.h"
@@ -66,6 +69,60 @@ public:
         return true;
     }
 
+	/**
+	 * Reimplementation from RS_EntityContainer. The number and the total
+	 * length of the selected entities are cached and kept up to date by
+	 * selectEntities(), other changes invalidate them. Only the deep count
+	 * of all types is cached.
+	 *
+	 * Selection changes are counted per document, see bumpSelectionSerial().
+	 * Freezing or thawing layers and blocks changes
+	 * RS_Entity::visibilitySerial() and invalidates the cache too.
+	 */
+	unsigned countSelected(bool deep=true, std::initializer_list<RS2::EntityType> const& types = {}) override;
+	double totalSelectedLength() override;
+	unsigned selectEntities(const std::vector<RS_Entity*>& entities, bool select) override;
+	/**
+	 * Reimplementation from RS_EntityContainer. The selected entities are
+	 * kept in a set, which is maintained by RS_Entity::setSelected() and by
+	 * adding and removing entities. They are returned in container order.
+	 * Undone entities stay in the set until they are removed, but are not
+	 * returned.
+	 */
+	std::vector<RS_Entity*> selectedEntities() override;
+	/**
+	 * @brief selectionChanged called by RS_Entity::setSelected() for direct
+	 * children of this document
+	 */
+	void selectionChanged(RS_Entity* entity, bool selected);
+
+	/**
+	 * Reimplementations from RS_EntityContainer, which keep the selection
+	 * set up to date.
+	 */
+	void addEntity(RS_Entity* entity) override;
+	void appendEntity(RS_Entity* entity) override;
+	void prependEntity(RS_Entity* entity) override;
+	void moveEntity(int index, QList<RS_Entity *>& entList) override;
+	void insertEntity(int index, RS_Entity* entity) override;
+	bool removeEntity(RS_Entity* entity) override;
+	void clear() override;
+	void detach() override;
+	/**
+	 * @brief bumpSelectionSerial called by RS_Entity::setSelected() and
+	 * RS_Entity::setVisible() for entities anywhere in this document.
+	 * Thread safe, entities of inserts may be selected concurrently.
+	 */
+	void bumpSelectionSerial() {
+		++selectionSerial.count;
+	}
+	/**
+	 * @brief checkSelection compares the maintained selection with a full
+	 * scan of the entities. Mismatches are reported as warnings.
+	 * @return true, if the selection set is consistent
+	 */
+	bool checkSelection();
+
     /**
      * Removes an entity from the entiy container. Implementation
      * from RS_Undo.
@@ -149,6 +206,54 @@ protected:
 	RS2::FormatType formatType;
     RS_GraphicView * gv;//used to read/save current view
 
+private:
+	bool isSelectionTallyValid() const;
+	void updateSelectionTally();
+	void updateSelectionSet();
+	void addToSelectionSet(RS_Entity* entity, int index);
+
+	//! cached results of countSelected() and totalSelectedLength()
+	struct SelectionTally {
+		bool valid = false;
+		unsigned long long generation = 0;
+		unsigned long long serial = 0;
+		unsigned long long visibility = 0;
+		unsigned count = 0;
+		double length = 0.;
+	};
+	SelectionTally selectionTally;
+
+	//! number of selection changes in this document
+	struct SelectionSerial {
+		SelectionSerial() = default;
+		SelectionSerial(const SelectionSerial& other): count{other.count.load()} {}
+		SelectionSerial& operator = (const SelectionSerial& other) {
+			count = other.count.load();
+			return *this;
+		}
+		std::atomic<unsigned long long> count{0};
+	};
+	SelectionSerial selectionSerial;
+
+	//! selected direct children, and the order of all direct children
+	struct SelectionSet {
+		SelectionSet() = default;
+		//! copies of a document own other entities
+		SelectionSet(const SelectionSet&) {}
+		SelectionSet& operator = (const SelectionSet&) {
+			valid = false;
+			entities.clear();
+			order.clear();
+			return *this;
+		}
+		bool valid = false;
+		std::unordered_set<RS_Entity*> entities;
+		//! increasing keys in container order
+		std::unordered_map<RS_Entity const*, double> order;
+		double first = 0.;
+		double last = 0.;
+	};
+	SelectionSet selectionSet;
 };
 
 
@@ -38,6 +38,7 @@
 #include  "lc_quadratic.h"
 #include "rs_painterqt.h"
 #include "rs_debug.h"
+#include "lc_rect.h"
 
 #ifdef EMU_C99
 #include "emu_c99.h" /* C99 math */
@@ -310,6 +311,17 @@ RS_Vector RS_Ellipse::getTangentDirection(const RS_Vector& point) const {
     return direction;
 }
 
+bool RS_Ellipse::isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const
+{
+	LC_Rect const window{v1, v2};
+	if (!window.intersects(LC_Rect{getMin(), getMax()}))
+		return false;
+	if (!isEllipticArc())
+		return window.intersectsEllipse(data.center, data.majorP, data.ratio, 0., 0.);
+	return window.intersectsEllipse(data.center, data.majorP, data.ratio,
+									data.angle1, data.angle2, data.reversed);
+}
+
 /**
   * find total length of the ellipse (arc)
   *
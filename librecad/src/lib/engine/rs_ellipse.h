@@ -87,6 +87,7 @@ public:
 	void moveStartpoint(const RS_Vector& pos) override;
 	void moveEndpoint(const RS_Vector& pos) override;
 	double getLength() const override;
+	bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const override;
 
     /**
     //Ellipse must have ratio<1, and not reversed
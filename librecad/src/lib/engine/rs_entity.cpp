@@ -26,6 +26,7 @@
 **********************************************************************/
 
 
+#include <atomic>
 #include <iostream>
 #include <utility>
 #include <QPolygon>
@@ -48,6 +49,7 @@
 #include "rs_vector.h"
 #include "rs_information.h"
 #include "lc_quadratic.h"
+#include "lc_rect.h"
 #include "rs_debug.h"
 
 /**
@@ -96,7 +98,8 @@ void RS_Entity::init() {
  * Gives this entity a new unique id.
  */
 void RS_Entity::initId() {
-    static unsigned long int idCounter=0;
+    // entities may be created concurrently, see LC_Parallel
+    static std::atomic<unsigned long int> idCounter{0};
     id = idCounter++;
 }
 
@@ -134,6 +137,15 @@ bool RS_Entity::setSelected(bool select) {
         return false;
     }
 
+    if (select != getFlag(RS2::FlagSelected) && parent) {
+        RS_Document* doc = parent->getDocument();
+        if (doc) {
+            doc->bumpSelectionSerial();
+            if (doc == parent) {
+                doc->selectionChanged(this, select);
+            }
+        }
+    }
     if (select) {
         setFlag(RS2::FlagSelected);
     } else {
@@ -143,6 +155,19 @@ bool RS_Entity::setSelected(bool select) {
     return true;
 }
 
+namespace {
+// layers are frozen and thawed in one thread, atomic for concurrent readers
+std::atomic<unsigned long long> visibilityChanges{0};
+}
+
+unsigned long long RS_Entity::visibilitySerial() {
+	return visibilityChanges;
+}
+
+void RS_Entity::bumpVisibilitySerial() {
+	++visibilityChanges;
+}
+
 
 
 /**
@@ -222,6 +247,9 @@ void RS_Entity::undoStateChanged(bool undone)
 
     setSelected(false);
     update();
+    if (parent) {
+        parent->bumpGeneration();
+    }
 }
 
 
@@ -256,6 +284,24 @@ bool RS_Entity::isInWindow(RS_Vector v1, RS_Vector v2) const
             getMax().y<=top);
 }
 
+bool RS_Entity::isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const
+{
+	LC_Rect const window{v1, v2};
+	if (!window.intersects(LC_Rect{getMin(), getMax()}))
+		return false;
+	if (isInWindow(v1, v2))
+		return true;
+
+	// generic test against the window borders
+	auto const corners = window.vertices();
+	for (size_t i = 0; i < corners.size(); ++i) {
+		RS_Line const border{corners[i], corners[(i + 1) % corners.size()]};
+		if (RS_Information::getIntersection(this, &border, true).hasValid())
+			return true;
+	}
+	return false;
+}
+
 double RS_Entity::areaLineIntegral() const
 {
 	return 0.;
@@ -418,6 +464,11 @@ bool RS_Entity::isVisible() const{
 }
 
 void RS_Entity::setVisible(bool v) {
+	if (v != getFlag(RS2::FlagVisible) && parent) {
+		RS_Document* doc = parent->getDocument();
+		if (doc)
+			doc->bumpSelectionSerial();
+	}
 	if (v) {
 		setFlag(RS2::FlagVisible);
 	} else {
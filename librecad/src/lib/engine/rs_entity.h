@@ -195,6 +195,18 @@ public:
     virtual bool isProcessed() const;
     virtual void setProcessed(bool on);
 	bool isInWindow(RS_Vector v1, RS_Vector v2) const;
+	/**
+	 * @brief isInCrossWindow whether any part of this entity lies within the
+	 * window v1-v2, i.e. the entity is within or crosses the window border
+	 */
+	virtual bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const;
+	/**
+	 * @brief visibilitySerial counter increased whenever a layer or block is
+	 * frozen or thawed. Container generations don't change then, caches of
+	 * visible or selected entities compare this counter too.
+	 */
+	static unsigned long long visibilitySerial();
+	static void bumpVisibilitySerial();
     virtual bool hasEndpointsWithinWindow(const RS_Vector& /*v1*/, const RS_Vector& /*v2*/) {
         return false;
     }
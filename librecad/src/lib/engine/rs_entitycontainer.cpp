@@ -136,6 +136,7 @@ void RS_EntityContainer::detach() {
         entities.append(e);
         e->reparent(this);
     }
+    ++generation;
 }
 
 
@@ -239,6 +240,7 @@ void RS_EntityContainer::selectWindow(RS_Vector v1, RS_Vector v2,
                                       bool select, bool cross) {
 
     bool included;
+	std::vector<RS_Entity*> selection;
 
 	for(auto e: entities){
 
@@ -249,47 +251,74 @@ void RS_EntityContainer::selectWindow(RS_Vector v1, RS_Vector v2,
                 //e->setSelected(select);
                 included = true;
 			} else if (cross) {
-				RS_EntityContainer l;
-				l.addRectangle(v1, v2);
-                RS_VectorSolutions sol;
-
-                if (e->isContainer()) {
-                    RS_EntityContainer* ec = (RS_EntityContainer*)e;
-                    for (RS_Entity* se=ec->firstEntity(RS2::ResolveAll);
-						 se && included==false;
-                         se=ec->nextEntity(RS2::ResolveAll)) {
-
-                        if (se->rtti() == RS2::EntitySolid){
-							included = static_cast<RS_Solid*>(se)->isInCrossWindow(v1,v2);
-                        } else {
-							for (auto line: l) {
-                                sol = RS_Information::getIntersection(
-											se, line, true);
-                                if (sol.hasValid()) {
-                                    included = true;
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                } else if (e->rtti() == RS2::EntitySolid){
-					included = static_cast<RS_Solid*>(e)->isInCrossWindow(v1,v2);
-                } else {
-					for (auto line: l) {
-						sol = RS_Information::getIntersection(e, line, true);
-                        if (sol.hasValid()) {
-                            included = true;
-                            break;
-                        }
-                    }
-                }
+				included = e->isInCrossWindow(v1, v2);
             }
         }
 
         if (included) {
-            e->setSelected(select);
+			selection.push_back(e);
         }
     }
+	selectEntities(selection, select);
+}
+
+
+std::vector<RS_Entity*> RS_EntityContainer::selectedEntities() {
+	std::vector<RS_Entity*> ret;
+	for (auto e: entities) {
+		if (e && e->isSelected())
+			ret.push_back(e);
+	}
+	return ret;
+}
+
+unsigned RS_EntityContainer::selectEntities(const std::vector<RS_Entity*>& entities, bool select) {
+	long long countDelta = 0;
+	double lengthDelta = 0.;
+	return changeSelection(entities, select, countDelta, lengthDelta);
+}
+
+
+namespace {
+/**
+ * Selects an entity like RS_EntityContainer::setSelected() and adds the
+ * resulting change of countSelected() to countDelta, in one walk of the
+ * entity tree.
+ */
+bool selectTree(RS_Entity* e, bool select, long long& countDelta) {
+	bool const before = e->isSelected();
+	if (!e->RS_Entity::setSelected(select))
+		return false;
+	countDelta += static_cast<long long>(e->isSelected()) - before;
+	if (e->isContainer()) {
+		for (RS_Entity* child: *static_cast<RS_EntityContainer*>(e)) {
+			if (child->isVisible())
+				selectTree(child, select, countDelta);
+		}
+	}
+	return true;
+}
+}
+
+unsigned RS_EntityContainer::changeSelection(const std::vector<RS_Entity*>& entities, bool select,
+											 long long& countDelta, double& lengthDelta) {
+	unsigned changed = 0;
+	countDelta = 0;
+	lengthDelta = 0.;
+	for (RS_Entity* e: entities) {
+		if (!e || e->isSelected() == select)
+			continue;
+		if (!selectTree(e, select, countDelta))
+			continue;
+		++changed;
+		// totalSelectedLength() only sums entities of this container
+		if (e->getParent() == this && e->isSelected() == select) {
+			double const l = e->getLength();
+			if (l >= 0.)
+				lengthDelta += select ? l : -l;
+		}
+	}
+	return changed;
 }
 
 
@@ -319,6 +348,7 @@ void RS_EntityContainer::addEntity(RS_Entity* entity) {
     } else {
         entities.append(entity);
     }
+    bumpGeneration();
     if (autoUpdateBorders) {
         adjustBorders(entity);
     }
@@ -333,6 +363,7 @@ void RS_EntityContainer::appendEntity(RS_Entity* entity){
 	if (!entity)
         return;
     entities.append(entity);
+    bumpGeneration();
     if (autoUpdateBorders)
         adjustBorders(entity);
 }
@@ -344,6 +375,7 @@ void RS_EntityContainer::appendEntity(RS_Entity* entity){
 void RS_EntityContainer::prependEntity(RS_Entity* entity){
 	if (!entity) return;
     entities.prepend(entity);
+    bumpGeneration();
     if (autoUpdateBorders)
         adjustBorders(entity);
 }
@@ -381,6 +413,7 @@ void RS_EntityContainer::moveEntity(int index, QList<RS_Entity *>& entList){
 	for(auto e: entList){
             entities.insert(ci++, e);
     }
+    bumpGeneration();
 }
 
 /**
@@ -391,6 +424,7 @@ void RS_EntityContainer::insertEntity(int index, RS_Entity* entity) {
 	if (!entity) return;
 
     entities.insert(index, entity);
+    bumpGeneration();
 
     if (autoUpdateBorders) {
         adjustBorders(entity);
@@ -430,6 +464,9 @@ bool RS_EntityContainer::removeEntity(RS_Entity* entity) {
 	//    in LibreCAD is never called with nullptr
     bool ret;
     ret = entities.removeOne(entity);
+    if (ret) {
+        bumpGeneration();
+    }
 
     if (autoDelete && ret) {
         delete entity;
@@ -451,9 +488,38 @@ void RS_EntityContainer::clear() {
             delete entities.takeFirst();
     } else
         entities.clear();
+    bumpGeneration();
     resetBorders();
 }
 
+/**
+ * Increases the change counter of this container and of all its parents.
+ */
+namespace {
+//! container where generation changes stop in this thread, see GenerationScope
+thread_local RS_EntityContainer const* generationRoot = nullptr;
+}
+
+void RS_EntityContainer::bumpGeneration() {
+	for (RS_EntityContainer* c = this; c; c = c->getParent()) {
+		++c->generation;
+		// previews are not among the entities of their parent
+		if (c->rtti() == RS2::EntityPreview || c == generationRoot)
+			break;
+	}
+}
+
+RS_EntityContainer::GenerationScope::GenerationScope(RS_EntityContainer const* root):
+	previous(generationRoot)
+{
+	generationRoot = root;
+}
+
+RS_EntityContainer::GenerationScope::~GenerationScope()
+{
+	generationRoot = previous;
+}
+
 unsigned int RS_EntityContainer::count() const{
     return entities.size();
 }
@@ -688,6 +754,24 @@ void RS_EntityContainer::updateInserts() {
 
 
 
+/**
+ * Updates the Insert entities in this container whose block, or one of
+ * its nested blocks, changed since their last update.
+ */
+void RS_EntityContainer::updateChangedInserts() {
+	for (RS_Entity* e: entities) {
+		if (e->rtti() == RS2::EntityInsert) {
+			RS_Insert* i = static_cast<RS_Insert*>(e);
+			if (i->isBlockChanged())
+				i->update();
+		} else if (e->isContainer() && e->rtti() != RS2::EntityHatch) {
+			static_cast<RS_EntityContainer*>(e)->updateChangedInserts();
+		}
+	}
+}
+
+
+
 /**
  * Renames all inserts with name 'oldName' to 'newName'. This is
  *   called after a block was rename to update the inserts.
@@ -1107,6 +1191,7 @@ void RS_EntityContainer::setEntityAt(int index,RS_Entity* en){
 		delete entities.at(index);
 	}
 	entities[index] = en;
+	bumpGeneration();
 }
 
 /**
@@ -1300,49 +1385,125 @@ RS_Vector RS_EntityContainer::getNearestDist(double distance,
 
 /**
  * @return The intersection which is closest to 'coord'
+ *
+ * The intersections of the entity closest to 'coord' are cached, so moving
+ * the cursor along the same entity doesn't repeat the intersection search
+ * until this container changes or a layer or block is frozen or thawed.
  */
 RS_Vector RS_EntityContainer::getNearestIntersection(const RS_Vector& coord,
                                                      double* dist) {
 
     double minDist = RS_MAXDOUBLE;  // minimum measured distance
-    double curDist = RS_MAXDOUBLE;  // currently measured distance
     RS_Vector closestPoint(false);  // closest found endpoint
-    RS_Vector point;                // endpoint found
-    RS_VectorSolutions sol;
     RS_Entity* closestEntity;
 
 	closestEntity = getNearestEntity(coord, nullptr, RS2::ResolveAllButTextImage);
 
 	if (closestEntity) {
-        for (RS_Entity* en = firstEntity(RS2::ResolveAllButTextImage);
-             en;
-             en = nextEntity(RS2::ResolveAllButTextImage)) {
-            if (
-                    !en->isVisible()
-					|| en->getParent()->ignoredSnap()
-                    ){
-                continue;
-            }
-
-            sol = RS_Information::getIntersection(closestEntity,
-                                                  en,
-                                                  true);
-
-			point=sol.getClosest(coord,&curDist,nullptr);
-            if(sol.getNumber()>0 && curDist<minDist){
-                closestPoint=point;
-                minDist=curDist;
-            }
-
-        }
-    }
+		IntersectionCache& cache = intersectionCache;
+		if (!cache.enabled
+				|| cache.entity != closestEntity
+				|| cache.entityId != closestEntity->getId()
+				|| cache.generation != generation
+				|| cache.visibility != RS_Entity::visibilitySerial()) {
+			cache.points = getIntersections(closestEntity);
+			cache.entity = closestEntity;
+			cache.entityId = closestEntity->getId();
+			cache.generation = generation;
+			cache.visibility = RS_Entity::visibilitySerial();
+		}
+
+		for (const auto& p: cache.points) {
+			double curDist = coord.squaredTo(p.first);
+			if (curDist < minDist) {
+				closestPoint = p.first;
+				minDist = curDist;
+			}
+		}
+
+		if (!cache.enabled) {
+			cache.entity = nullptr;
+			cache.points.clear();
+		}
+	}
 	if(dist && closestPoint.valid) {
-        *dist = minDist;
+		*dist = sqrt(minDist);
     }
 
     return closestPoint;
 }
 
+/**
+ * @brief RS_EntityContainer::getIntersections finds all intersections of
+ * the given entity with the snappable entities of this container. Only
+ * entities with overlapping bounding boxes are passed to
+ * RS_Information::getIntersection().
+ * @param entity the entity to intersect
+ * @return intersection points, each with the entity intersected
+ */
+std::vector<std::pair<RS_Vector, RS_Entity*>> RS_EntityContainer::getIntersections(
+		RS_Entity const* entity) const
+{
+	std::vector<std::pair<RS_Vector, RS_Entity*>> ret;
+	if (!entity) return ret;
+
+	std::vector<RS_Entity*> candidates;
+	if (entity->isConstruction()) {
+		// infinite lines, the bounding box is of no use
+		LC_Rect const all{RS_Vector{RS_MINDOUBLE, RS_MINDOUBLE},
+					RS_Vector{RS_MAXDOUBLE, RS_MAXDOUBLE}};
+		collectOverlapping(all, candidates);
+	} else {
+		collectOverlapping(LC_Rect{entity->getMin(), entity->getMax()},
+						   candidates);
+	}
+
+	for (RS_Entity* en: candidates) {
+		if (!en->isVisible() || en->getParent()->ignoredSnap())
+			continue;
+
+		RS_VectorSolutions const& sol = RS_Information::getIntersection(entity,
+																		en,
+																		true);
+		for (const RS_Vector& vp: sol) {
+			if (vp.valid)
+				ret.emplace_back(vp, en);
+		}
+	}
+	return ret;
+}
+
+void RS_EntityContainer::collectOverlapping(const LC_Rect& area,
+											std::vector<RS_Entity*>& candidates) const
+{
+	for (RS_Entity* e: entities) {
+		bool const isConstruction = e->isConstruction();
+		if (!isConstruction
+				&& !area.intersects(LC_Rect{e->getMin(), e->getMax()}, RS_TOLERANCE))
+			continue;
+
+		if (e->isContainer()
+				&& e->rtti() != RS2::EntityText && e->rtti() != RS2::EntityMText) {
+			auto ec = static_cast<RS_EntityContainer*>(e);
+			// nothing to snap to inside, e.g. hatches and dimensions
+			if (ec->ignoredSnap())
+				continue;
+			ec->collectOverlapping(area, candidates);
+		} else {
+			candidates.push_back(e);
+		}
+	}
+}
+
+void RS_EntityContainer::setIntersectionCacheEnabled(bool enable)
+{
+	intersectionCache.enabled = enable;
+	if (!enable) {
+		intersectionCache.entity = nullptr;
+		intersectionCache.points.clear();
+	}
+}
+
 RS_Vector RS_EntityContainer::getNearestVirtualIntersection(const RS_Vector& coord,
                                                             const double& angle,
                                                             double* dist)
@@ -1673,6 +1834,37 @@ bool RS_EntityContainer::hasEndpointsWithinWindow(const RS_Vector& v1, const RS_
 }
 
 
+/**
+ * A container crosses the window if one of its resolved entities crosses
+ * a window border. Entities completely inside of the window don't count,
+ * except for solids. Sub-containers outside of the window are skipped as
+ * a whole.
+ */
+bool RS_EntityContainer::isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const {
+	if (isInWindow(v1, v2))
+		return true;
+	return crossesWindowBorder(v1, v2);
+}
+
+bool RS_EntityContainer::crossesWindowBorder(const RS_Vector& v1, const RS_Vector& v2) const {
+	LC_Rect const window{v1, v2};
+	if (!window.intersects(LC_Rect{getMin(), getMax()}))
+		return false;
+	for (RS_Entity* e: entities) {
+		if (e->isUndone())
+			continue;
+		if (e->isContainer()) {
+			if (static_cast<RS_EntityContainer*>(e)->crossesWindowBorder(v1, v2))
+				return true;
+		} else if (e->isInCrossWindow(v1, v2)
+				   && (e->rtti() == RS2::EntitySolid || !e->isInWindow(v1, v2))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
 void RS_EntityContainer::move(const RS_Vector& offset) {
 	for(auto e: entities){
 
@@ -1684,6 +1876,7 @@ void RS_EntityContainer::move(const RS_Vector& offset) {
     if (autoUpdateBorders) {
         moveBorders(offset);
     }
+    bumpGeneration();
 }
 
 
@@ -1697,6 +1890,7 @@ void RS_EntityContainer::rotate(const RS_Vector& center, const double& angle) {
     if (autoUpdateBorders) {
         calculateBorders();
     }
+    bumpGeneration();
 }
 
 
@@ -1708,6 +1902,7 @@ void RS_EntityContainer::rotate(const RS_Vector& center, const RS_Vector& angleV
     if (autoUpdateBorders) {
         calculateBorders();
     }
+    bumpGeneration();
 }
 
 
@@ -1721,6 +1916,7 @@ void RS_EntityContainer::scale(const RS_Vector& center, const RS_Vector& factor)
     if (autoUpdateBorders) {
         calculateBorders();
     }
+    bumpGeneration();
 }
 
 
@@ -1732,6 +1928,7 @@ void RS_EntityContainer::mirror(const RS_Vector& axisPoint1, const RS_Vector& ax
             e->mirror(axisPoint1, axisPoint2);
         }
     }
+    bumpGeneration();
 }
 
 
@@ -1752,6 +1949,7 @@ void RS_EntityContainer::stretch(const RS_Vector& firstCorner,
 
     // some entitiycontainers might need an update (e.g. RS_Leader):
     update();
+    bumpGeneration();
 }
 
 
@@ -1766,6 +1964,7 @@ void RS_EntityContainer::moveRef(const RS_Vector& ref,
     if (autoUpdateBorders) {
         calculateBorders();
     }
+    bumpGeneration();
 }
 
 
@@ -1779,6 +1978,7 @@ void RS_EntityContainer::moveSelectedRef(const RS_Vector& ref,
     if (autoUpdateBorders) {
         calculateBorders();
     }
+    bumpGeneration();
 }
 
 void RS_EntityContainer::revertDirection() {
@@ -1789,6 +1989,7 @@ void RS_EntityContainer::revertDirection() {
 	for(RS_Entity*const entity: entities) {
 		entity->revertDirection();
 	}
+	bumpGeneration();
 }
 
 /**
@@ -1875,6 +2076,11 @@ bool RS_EntityContainer::ignoredSnap() const
 	return ignoredOnModification();
 }
 
+LC_EntityRange RS_EntityContainer::deepEntities(RS2::ResolveLevel level) const
+{
+	return {*this, level};
+}
+
 QList<RS_Entity *>::const_iterator RS_EntityContainer::begin() const
 {
 	return entities.begin();
@@ -28,8 +28,11 @@
 #ifndef RS_ENTITYCONTAINER_H
 #define RS_ENTITYCONTAINER_H
 
+#include <utility>
 #include <vector>
 #include "rs_entity.h"
+#include "lc_rect.h"
+#include "lc_entityiterator.h"
 
 /**
  * Class representing a tree of entities.
@@ -81,6 +84,18 @@ public:
 
 	virtual void selectWindow(RS_Vector v1, RS_Vector v2,
 				bool select=true, bool cross=false);
+	/**
+	 * @brief selectEntities selects or deselects the given entities of this
+	 * container in one pass. Entities which are already in the requested
+	 * state are skipped without visiting their sub-entities.
+	 * @return number of entities whose selection changed
+	 */
+	virtual unsigned selectEntities(const std::vector<RS_Entity*>& entities, bool select);
+	/**
+	 * @brief selectedEntities the selected direct children of this container.
+	 * The result is a copy, the selection may be changed while iterating.
+	 */
+	virtual std::vector<RS_Entity*> selectedEntities();
 
     virtual void addEntity(RS_Entity* entity);
     virtual void appendEntity(RS_Entity* entity);
@@ -129,11 +144,39 @@ public:
     virtual void setAutoUpdateBorders(bool enable) {
         autoUpdateBorders = enable;
     }
+	/**
+	 * @brief getGeneration change counter of this container. It is increased
+	 * whenever entities are added, removed, transformed or undone in this
+	 * container or in one of its sub-containers. Used to invalidate caches.
+	 */
+	unsigned long long getGeneration() const {
+		return generation;
+	}
+	void bumpGeneration();
+	/**
+	 * @brief The GenerationScope class stops the propagation of generation
+	 * changes at root for the current thread, while it is alive. This allows
+	 * to regenerate sub-containers of the same parent concurrently; the
+	 * parent generation must be bumped afterwards.
+	 */
+	class GenerationScope {
+	public:
+		explicit GenerationScope(RS_EntityContainer const* root);
+		~GenerationScope();
+	private:
+		RS_EntityContainer const* previous;
+	};
+	/**
+	 * Enables / disables caching of the intersections found by
+	 * getNearestIntersection(). By default this is turned on.
+	 */
+	void setIntersectionCacheEnabled(bool enable);
     virtual void adjustBorders(RS_Entity* entity);
 	void calculateBorders() override;
 	void forcedCalculateBorders();
 	void updateDimensions( bool autoText=true);
     virtual void updateInserts();
+	virtual void updateChangedInserts();
     virtual void updateSplines();
 	void update() override;
 	virtual void renameInserts(const QString& oldName,
@@ -164,6 +207,8 @@ public:
 									 double* dist = nullptr) const override;
 	RS_Vector getNearestIntersection(const RS_Vector& coord,
 			double* dist = nullptr);
+	//! intersections of entity with all snappable entities of this container
+	std::vector<std::pair<RS_Vector, RS_Entity*>> getIntersections(RS_Entity const* entity) const;
     RS_Vector getNearestVirtualIntersection(const RS_Vector& coord,
                                             const double& angle,
                                             double* dist);
@@ -180,6 +225,7 @@ public:
     virtual bool optimizeContours();
 
 	bool hasEndpointsWithinWindow(const RS_Vector& v1, const RS_Vector& v2) override;
+	bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const override;
 
 	void move(const RS_Vector& offset) override;
 	void rotate(const RS_Vector& center, const double& angle) override;
@@ -214,6 +260,11 @@ public:
      * @return, true, indicate this entity container should be ignored
      */
     bool ignoredOnModification() const;
+	/**
+	 * @brief ignoredSnap whether snapping is ignored
+	 * @return true when entity of this container won't be considered for snapping points
+	 */
+	bool ignoredSnap() const;
 
 	/**
 	 * @brief begin/end to support range based loop
@@ -223,6 +274,12 @@ public:
 	QList<RS_Entity *>::const_iterator end() const;
 	QList<RS_Entity *>::iterator begin() ;
 	QList<RS_Entity *>::iterator end() ;
+	/**
+	 * @brief deepEntities entities of this container and its sub containers
+	 * for the given resolve level, without using the iteration state of
+	 * firstEntity()/nextEntity(). Undone entities are skipped.
+	 */
+	LC_EntityRange deepEntities(RS2::ResolveLevel level) const;
 	//! \{
 	//! first and last without resolving into children, assume the container is
 	//! not empty
@@ -233,6 +290,12 @@ public:
     const QList<RS_Entity*>& getEntityList();
 
 protected:
+	/**
+	 * @brief changeSelection implements selectEntities(), reports the
+	 * resulting change of countSelected() and totalSelectedLength()
+	 */
+	unsigned changeSelection(const std::vector<RS_Entity*>& entities, bool select,
+							 long long& countDelta, double& lengthDelta);
 
     /** entities in the container */
     QList<RS_Entity *> entities;
@@ -248,12 +311,32 @@ protected:
 
 private:
 	/**
-	 * @brief ignoredSnap whether snapping is ignored
-	 * @return true when entity of this container won't be considered for snapping points
+	 * @brief crossesWindowBorder whether a resolved entity of this container
+	 * crosses a border of the window v1-v2, see isInCrossWindow()
 	 */
-	bool ignoredSnap() const;
+	bool crossesWindowBorder(const RS_Vector& v1, const RS_Vector& v2) const;
+	/**
+	 * @brief collectOverlapping broad phase for intersections: collects the
+	 * leaves (resolved like RS2::ResolveAllButTextImage) whose bounding box
+	 * overlaps area. Sub-containers outside of area are skipped as a whole.
+	 */
+	void collectOverlapping(const LC_Rect& area,
+							std::vector<RS_Entity*>& candidates) const;
     int entIdx;
     bool autoDelete;
+	unsigned long long generation = 0;
+
+	/** intersections of the entity last caught by getNearestIntersection() */
+	struct IntersectionCache {
+		bool enabled = true;
+		RS_Entity const* entity = nullptr;
+		unsigned long int entityId = 0;
+		unsigned long long generation = 0;
+		//! RS_Entity::visibilitySerial() when the points were found
+		unsigned long long visibility = 0;
+		std::vector<std::pair<RS_Vector, RS_Entity*>> points;
+	};
+	IntersectionCache intersectionCache;
 };
 
 #endif
@@ -26,6 +26,9 @@
 
 #include <iostream>
 #include <cmath>
+#include <map>
+#include <set>
+#include <memory>
 #include <QDir>
 //#include <QDebug>
 
@@ -34,11 +37,20 @@
 
 #include "rs_debug.h"
 #include "rs_fileio.h"
+#include "lc_filtersnapshot.h"
 #include "rs_math.h"
 #include "rs_units.h"
 #include "rs_settings.h"
 #include "rs_layer.h"
 #include "rs_block.h"
+#include "rs_insert.h"
+#include "rs_hatch.h"
+#include "rs_text.h"
+#include "rs_mtext.h"
+#include "rs_font.h"
+#include "rs_fontlist.h"
+#include "rs_patternlist.h"
+#include "lc_parallel.h"
 
 
 /**
@@ -299,6 +311,15 @@ bool RS_Graphic::BackupDrawingFile(const QString &filename)
 
 bool RS_Graphic::save(bool isAutoSave)
 {
+    // a running background auto save finishes first, it mustn't write
+    // the auto save files again after a manual save removed them
+    waitForAutoSave();
+    if (isAutoSave) {
+        std::function<bool()> task = autoSaveTask();
+        // empty if the drawing isn't modified
+        return !task || task();
+    }
+
     bool ret	= false;
 
     RS_DEBUG->print("RS_Graphic::save: Entering...");
@@ -315,22 +336,15 @@ bool RS_Graphic::save(bool isAutoSave)
 
         actualType	= formatType;
 
-		if (isAutoSave)
-        {
-			actualName = autosaveFilename;
-
-            if (formatType == RS2::FormatUnknown)
-                actualType = RS2::FormatDXFRW;
-		} else {
-			//	- This is not an AutoSave operation.  This is a manual
-			//	  save operation.  So, ...
-			//		- Set working file name to the drawing file name.
-			//		- Backup drawing file (if necessary).
-			//	------------------------------------------------------
-			QFileInfo	finfo(filename);
-			QDateTime m=finfo.lastModified();
-            //bug#3414993
-            //modifiedTime should only be used for the same filename
+		//	- This is not an AutoSave operation.  This is a manual
+		//	  save operation.  So, ...
+		//		- Set working file name to the drawing file name.
+		//		- Backup drawing file (if necessary).
+		//	------------------------------------------------------
+		QFileInfo	finfo(filename);
+		QDateTime m=finfo.lastModified();
+        //bug#3414993
+        //modifiedTime should only be used for the same filename
 //            DEBUG_HEADER
 //            qDebug()<<"currentFileName= "<<currentFileName;
 //            qDebug()<<"Checking file: filename= "<<filename;
@@ -338,19 +352,18 @@ bool RS_Graphic::save(bool isAutoSave)
 //            qDebug()<<"modifiedTime.isValid()="<<modifiedTime.isValid();
 //            qDebug()<<"Previous timestamp: "<<modifiedTime;
 //            qDebug()<<"Current timestamp: "<<m;
-            if ( currentFileName == QString(filename)
-                 && modifiedTime.isValid() && m != modifiedTime ) {
-                //file modified by others
+        if ( currentFileName == QString(filename)
+             && modifiedTime.isValid() && m != modifiedTime ) {
+            //file modified by others
 //            qDebug()<<"detected on disk change";
-                RS_DIALOGFACTORY->commandMessage(QObject::tr("File on disk modified. Please save to another file to avoid data loss! File modified: %1").arg(filename));
-                return false;
-            }
-
-			actualName = filename;
-            if (RS_SETTINGS->readNumEntry("/AutoBackupDocument", 1)!=0)
-                BackupDrawingFile(filename);
+            RS_DIALOGFACTORY->commandMessage(QObject::tr("File on disk modified. Please save to another file to avoid data loss! File modified: %1").arg(filename));
+            return false;
         }
 
+		actualName = filename;
+        if (RS_SETTINGS->readNumEntry("/AutoBackupDocument", 1)!=0)
+            BackupDrawingFile(filename);
+
         /*	Save drawing file if able to created associated object.
                  *	------------------------------------------------------- */
 		if (!actualName.isEmpty())
@@ -370,7 +383,7 @@ bool RS_Graphic::save(bool isAutoSave)
 
         /*	Remove AutoSave file after user has successfully saved file.
                  *	------------------------------------------------------------ */
-        if (ret && !isAutoSave)
+        if (ret)
         {
             /*	Autosave file object.
                          *	*/
@@ -391,6 +404,7 @@ bool RS_Graphic::save(bool isAutoSave)
 									autosaveFilename.toLatin1().data());
 				qf_file.remove();
 			}
+			QFile::remove(getAutoSaveSnapshotFilename());
 
         }
 
@@ -509,6 +523,99 @@ bool RS_Graphic::loadTemplate(const QString &filename, RS2::FormatType type) {
     return ret;
 }
 
+/**
+ * Prepares an auto save. Everything that needs the document, the settings
+ * or the GUI thread happens here: the drawing is copied as a snapshot,
+ * which is cheap, and a graphic for the DXF export is constructed.
+ *
+ * @return the task writing the auto save files, it may run on any
+ * thread. Empty if the drawing isn't modified.
+ */
+std::function<bool()> RS_Graphic::autoSaveTask()
+{
+	if (!isModified())
+		return {};
+
+	RS2::FormatType type = formatType;
+	if (type == RS2::FormatUnknown)
+		type = RS2::FormatDXFRW;
+
+	// binary DXF is written and read much faster
+	RS_SETTINGS->beginGroup("/Defaults");
+	bool binary = RS_SETTINGS->readNumEntry("/AutoSaveBinary", 1) != 0;
+	// a snapshot next to the auto save file to recover from quickly
+	bool snapshot = RS_SETTINGS->readNumEntry("/AutoSaveSnapshot", 1) != 0;
+	RS_SETTINGS->endGroup();
+	if (binary
+		&& (type == RS2::FormatDXFRW || type == RS2::FormatDXFRW2004
+			|| type == RS2::FormatDXFRW2000 || type == RS2::FormatDXFRW14
+			|| type == RS2::FormatDXFRW12))
+		type = RS2::FormatDXFRWBinary;
+
+	QString const name = autosaveFilename;
+	QString const snapshotName = getAutoSaveSnapshotFilename();
+	QByteArray const data = LC_FilterSnapshot::serialize(*this);
+	// the constructor reads the settings, so not on the worker
+	auto copy = std::make_shared<RS_Graphic>();
+	// the copy is regenerated on the worker: the writers need the
+	// geometry of dimensions and hatches, e.g. for their blocks in DXF
+	loadResources();
+	RS_FileIO* io = RS_FileIO::instance();
+
+	return [=]() {
+		RS_DEBUG->print("RS_Graphic::autoSaveTask: %s", name.toLatin1().data());
+		if (snapshot && !LC_FilterSnapshot::writeFile(snapshotName, data))
+			RS_DEBUG->print(RS_Debug::D_WARNING,
+							"RS_Graphic::autoSaveTask: can't write %s",
+							snapshotName.toLatin1().data());
+		if (type == RS2::FormatSnapshot)
+			return LC_FilterSnapshot::writeFile(name, data);
+		return LC_FilterSnapshot::deserialize(*copy, data, true)
+				&& io->fileExport(*copy, name, type);
+	};
+}
+
+/**
+ * Starts an auto save on a worker thread and returns at once, the
+ * document may be edited while the files are written. An auto save
+ * still running is not started again.
+ *
+ * @return the result, true on success or if there was nothing to save
+ */
+std::shared_future<bool> RS_Graphic::autoSaveInBackground()
+{
+	if (autoSaveResult.valid()
+		&& autoSaveResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return autoSaveResult;
+
+	std::function<bool()> task = autoSaveTask();
+	if (!task) {
+		std::promise<bool> nothingToDo;
+		nothingToDo.set_value(true);
+		return nothingToDo.get_future().share();
+	}
+	autoSaveResult = std::async(std::launch::async, std::move(task)).share();
+	return autoSaveResult;
+}
+
+/**
+ * Blocks until an auto save started by autoSaveInBackground() finished.
+ */
+void RS_Graphic::waitForAutoSave()
+{
+	if (autoSaveResult.valid())
+		autoSaveResult.wait();
+}
+
+/**
+ * @return name of the snapshot written with each auto save, the auto save
+ * file name with the extension of LibreCAD snapshots appended
+ */
+QString RS_Graphic::getAutoSaveSnapshotFilename() const
+{
+	return autosaveFilename + "." + LC_FilterSnapshot::extension();
+}
+
 /**
  * Loads the given file into this graphic.
  */
@@ -949,9 +1056,264 @@ bool RS_Graphic::isBiggerThanPaper() {
 }
 
 
+/**
+ * Updates the inserts of all blocks, nested blocks first and each block
+ * only once per change, then all inserts of this graphic.
+ */
+namespace {
+/**
+ * Prepares updating inserts of blk concurrently: loads the fonts and
+ * patterns of the texts and hatches in blk and its nested blocks.
+ *
+ * @return false if inserts of blk must be updated serially. Copies of
+ * dimensions and leaders read and add variables of the graphic on update,
+ * mtexts with font changes load fonts on demand.
+ */
+bool prepareConcurrentUpdate(RS_Block* blk, std::map<RS_Block*, bool>& blocks,
+							 std::set<RS_Font*>& fonts)
+{
+	auto it = blocks.find(blk);
+	if (it != blocks.end())
+		return it->second;
+	// recursive block references are updated serially
+	blocks[blk] = false;
+
+	bool concurrent = true;
+	for (RS_Entity* e: *blk) {
+		switch (e->rtti()) {
+		case RS2::EntityDimAligned:
+		case RS2::EntityDimLinear:
+		case RS2::EntityDimRadial:
+		case RS2::EntityDimDiametric:
+		case RS2::EntityDimAngular:
+		case RS2::EntityDimLeader:
+			concurrent = false;
+			break;
+		case RS2::EntityHatch: {
+			RS_Hatch* hatch = static_cast<RS_Hatch*>(e);
+			if (!hatch->isSolid())
+				RS_PATTERNLIST->requestPattern(hatch->getPattern());
+			break;
+		}
+		case RS2::EntityText:
+			fonts.insert(RS_FONTLIST->requestFont(static_cast<RS_Text*>(e)->getStyle()));
+			break;
+		case RS2::EntityMText: {
+			RS_MText* text = static_cast<RS_MText*>(e);
+			fonts.insert(RS_FONTLIST->requestFont(text->getStyle()));
+			if (text->getText().contains("\\f", Qt::CaseInsensitive))
+				concurrent = false;
+			break;
+		}
+		case RS2::EntityInsert: {
+			RS_Block* nested = static_cast<RS_Insert*>(e)->getBlockForInsert();
+			if (nested && !prepareConcurrentUpdate(nested, blocks, fonts))
+				concurrent = false;
+			break;
+		}
+		default:
+			break;
+		}
+	}
+	blocks[blk] = concurrent;
+	return concurrent;
+}
+}
+
+void RS_Graphic::updateInserts()
+{
+	for (RS_Block* blk: blockList.sortedByDependency())
+		blk->updateNestedInserts();
+
+	// with their blocks up to date, the inserts of the model space are
+	// independent of each other. Shared state they would change on update
+	// is prepared here, inserts which can't be prepared stay serial
+	std::vector<RS_EntityContainer*> inserts;
+	std::vector<RS_Insert*> serial;
+	std::map<RS_Block*, bool> blocks;
+	std::set<RS_Font*> fonts;
+	for (RS_Entity* e: entities) {
+		if (e->rtti() == RS2::EntityInsert) {
+			RS_Insert* insert = static_cast<RS_Insert*>(e);
+			RS_Block* blk = insert->getBlockForInsert();
+			if (!blk || prepareConcurrentUpdate(blk, blocks, fonts))
+				inserts.push_back(insert);
+			else
+				serial.push_back(insert);
+		} else if (e->isContainer() && e->rtti() != RS2::EntityHatch) {
+			static_cast<RS_EntityContainer*>(e)->updateInserts();
+		}
+	}
+
+	// letters are inserts of the font blocks, prepare their caches
+	fonts.erase(nullptr);
+	for (RS_Font* font: fonts) {
+		for (RS_Block* letter: *font->getLetterList())
+			letter->updateNestedInserts();
+	}
+	// the inserts read the dependency stamps of their blocks
+	for (auto const& b: blocks)
+		b.first->getDependencyStamp();
+
+	updateConcurrently(inserts);
+	for (RS_Insert* insert: serial)
+		insert->update();
+}
+
+
+/**
+ * Like updateInserts(), but only updates inserts of changed blocks.
+ */
+void RS_Graphic::updateChangedInserts()
+{
+	for (RS_Block* blk: blockList.sortedByDependency())
+		blk->updateNestedInserts();
+	RS_EntityContainer::updateChangedInserts();
+}
+
+
+/**
+ * Updates the given entities of this graphic or of its blocks, followed
+ * by all inserts. Used after loading a file with entity updates deferred.
+ *
+ * Texts and hatches are regenerated concurrently, after loading the fonts
+ * and patterns they use. Other entities are updated one by one.
+ */
+void RS_Graphic::updateEntities(const std::vector<RS_Entity*>& entities)
+{
+	std::vector<RS_EntityContainer*> concurrent;
+	std::vector<RS_Entity*> serial;
+	std::set<RS_Font*> fonts;
+	for (RS_Entity* e: entities) {
+		switch (e->rtti()) {
+		case RS2::EntityHatch: {
+			RS_Hatch* hatch = static_cast<RS_Hatch*>(e);
+			if (!hatch->isSolid())
+				RS_PATTERNLIST->requestPattern(hatch->getPattern());
+			concurrent.push_back(hatch);
+			break;
+		}
+		case RS2::EntityText: {
+			RS_Text* text = static_cast<RS_Text*>(e);
+			fonts.insert(RS_FONTLIST->requestFont(text->getStyle()));
+			concurrent.push_back(text);
+			break;
+		}
+		case RS2::EntityMText: {
+			RS_MText* text = static_cast<RS_MText*>(e);
+			fonts.insert(RS_FONTLIST->requestFont(text->getStyle()));
+			// font changes within the text load further fonts on demand
+			if (text->getText().contains("\\f", Qt::CaseInsensitive))
+				serial.push_back(text);
+			else
+				concurrent.push_back(text);
+			break;
+		}
+		default:
+			serial.push_back(e);
+			break;
+		}
+	}
+
+	// letters are inserts of the font blocks, prepare their caches
+	fonts.erase(nullptr);
+	for (RS_Font* font: fonts) {
+		for (RS_Block* letter: *font->getLetterList())
+			letter->updateNestedInserts();
+	}
+
+	updateConcurrently(concurrent);
+	for (RS_Entity* e: serial)
+		e->update();
+
+	std::set<RS_EntityContainer*> parents;
+	for (RS_Entity* e: entities)
+		parents.insert(e->getParent());
+	parents.erase(nullptr);
+	for (RS_EntityContainer* parent: parents)
+		parent->calculateBorders();
+
+	updateInserts();
+}
+
+
+/**
+ * Loads the fonts and patterns the texts, dimensions and hatches of this
+ * graphic and its blocks use, and prepares the letters of the fonts.
+ * Afterwards, a copy of this graphic can be regenerated on a worker
+ * thread without changing the shared font and pattern lists. Fonts of
+ * font changes within mtexts were loaded when the mtexts were generated.
+ */
+void RS_Graphic::loadResources()
+{
+	std::set<RS_Font*> fonts;
+	bool dimensions = false;
+	auto load = [&fonts, &dimensions](RS_EntityContainer& c) {
+		for (RS_Entity* e: c) {
+			switch (e->rtti()) {
+			case RS2::EntityHatch: {
+				RS_Hatch* hatch = static_cast<RS_Hatch*>(e);
+				if (!hatch->isSolid())
+					RS_PATTERNLIST->requestPattern(hatch->getPattern());
+				break;
+			}
+			case RS2::EntityText:
+				fonts.insert(RS_FONTLIST->requestFont(static_cast<RS_Text*>(e)->getStyle()));
+				break;
+			case RS2::EntityMText:
+				fonts.insert(RS_FONTLIST->requestFont(static_cast<RS_MText*>(e)->getStyle()));
+				break;
+			case RS2::EntityDimAligned:
+			case RS2::EntityDimLinear:
+			case RS2::EntityDimRadial:
+			case RS2::EntityDimDiametric:
+			case RS2::EntityDimAngular:
+				dimensions = true;
+				break;
+			default:
+				break;
+			}
+		}
+	};
+	load(*this);
+	for (RS_Block* blk: blockList)
+		load(*blk);
+	if (dimensions)
+		fonts.insert(RS_FONTLIST->requestFont(getVariableString("$DIMTXSTY", "standard")));
+
+	fonts.erase(nullptr);
+	for (RS_Font* font: fonts) {
+		for (RS_Block* letter: *font->getLetterList())
+			letter->updateNestedInserts();
+	}
+}
+
+
+/**
+ * Updates the given containers concurrently. Each container must only
+ * depend on entities which are not updated at the same time.
+ */
+void RS_Graphic::updateConcurrently(const std::vector<RS_EntityContainer*>& containers)
+{
+	LC_Parallel::forRange(containers.size(), [&containers](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			RS_EntityContainer::GenerationScope scope(containers[i]);
+			containers[i]->update();
+		}
+	}, 8);
+
+	std::set<RS_EntityContainer*> parents;
+	for (RS_EntityContainer* c: containers)
+		parents.insert(c->getParent());
+	parents.erase(nullptr);
+	for (RS_EntityContainer* parent: parents)
+		parent->bumpGeneration();
+}
+
+
 void RS_Graphic::addEntity(RS_Entity* entity)
 {
-    RS_EntityContainer::addEntity(entity);
+    RS_Document::addEntity(entity);
     if( entity->rtti() == RS2::EntityBlock ||
             entity->rtti() == RS2::EntityContainer){
         RS_EntityContainer* e=static_cast<RS_EntityContainer*>(entity);
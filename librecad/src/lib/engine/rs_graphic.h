@@ -29,6 +29,9 @@
 #ifndef RS_GRAPHIC_H
 #define RS_GRAPHIC_H
 
+#include <functional>
+#include <future>
+#include <vector>
 #include <QDateTime>
 #include "rs_blocklist.h"
 #include "rs_layerlist.h"
@@ -69,6 +72,9 @@ public:
 
     virtual void newDoc();
     virtual bool save(bool isAutoSave = false);
+    QString getAutoSaveSnapshotFilename() const;
+    std::shared_future<bool> autoSaveInBackground();
+    void waitForAutoSave();
     virtual bool saveAs(const QString& filename, RS2::FormatType type, bool force = false);
     virtual bool open(const QString& filename, RS2::FormatType type);
     bool loadTemplate(const QString &filename, RS2::FormatType type);
@@ -96,6 +102,10 @@ public:
         layerList.add(layer);
     }
     virtual void addEntity(RS_Entity* entity);
+    virtual void updateInserts();
+    virtual void updateChangedInserts();
+    void updateEntities(const std::vector<RS_Entity*>& entities);
+    void loadResources();
     virtual void removeLayer(RS_Layer* layer);
     virtual void editLayer(RS_Layer* layer, const RS_Layer& source) {
         layerList.edit(layer, source);
@@ -358,6 +368,10 @@ public:
 private:
 
         bool BackupDrawingFile(const QString &filename);
+        void updateConcurrently(const std::vector<RS_EntityContainer*>& containers);
+        std::function<bool()> autoSaveTask();
+        //! result of the auto save running in the background, if any
+        std::shared_future<bool> autoSaveResult;
         QDateTime modifiedTime;
         QString currentFileName; //keep a copy of filename for the modifiedTime
 
@@ -30,6 +30,7 @@
 #include <QBrush>
 #include <QString>
 #include "rs_hatch.h"
+#include "lc_preparedcontour.h"
 
 #include "rs_arc.h"
 #include "rs_circle.h"
@@ -480,6 +481,8 @@ void RS_Hatch::update() {
     hatch->setFlag(RS2::FlagTemp);
 
     //calculateBorders();
+	// the hatch pattern is removed, only the loops are left
+	LC_PreparedContour const contour(this);
 	for(auto e: tmp2){
 
         RS_Vector middlePoint;
@@ -500,12 +503,8 @@ void RS_Hatch::update() {
         }
 
         if (middlePoint.valid) {
-            bool onContour=false;
-
-            if (RS_Information::isPointInsideContour(
-                        middlePoint,
-                        this, &onContour) ||
-                    RS_Information::isPointInsideContour(middlePoint2, this)) {
+            if (contour.isInside(middlePoint) ||
+                    contour.isInside(middlePoint2)) {
 
                 RS_Entity* te = e->clone();
                 te->setPen(hatch_pen);
@@ -745,10 +744,11 @@ double RS_Hatch::getDistanceToPoint(
             *entity = const_cast<RS_Hatch*>(this);
         }
 
-        bool onContour;
-        if (RS_Information::isPointInsideContour(
-                    coord,
-                     const_cast<RS_Hatch*>(this), &onContour)) {
+        if (!solidContour || solidContourGeneration != getGeneration()) {
+            solidContour = std::make_shared<LC_PreparedContour>(this);
+            solidContourGeneration = getGeneration();
+        }
+        if (solidContour->isInside(coord)) {
 
             // distance is the snap range:
             return solidDist;
@@ -28,6 +28,7 @@
 #ifndef RS_HATCH_H
 #define RS_HATCH_H
 
+#include <memory>
 #include "rs_entity.h"
 #include "rs_entitycontainer.h"
 
@@ -60,6 +61,8 @@ struct RS_HatchData {
 
 std::ostream& operator << (std::ostream& os, const RS_HatchData& td);
 
+class LC_PreparedContour;
+
 
 
 /**
@@ -170,6 +173,11 @@ protected:
         bool updateRunning;
         bool needOptimization;
         int  updateError;
+
+private:
+	//! contour of solid fills for getDistanceToPoint(), by generation
+	mutable std::shared_ptr<const LC_PreparedContour> solidContour;
+	mutable unsigned long long solidContourGeneration = 0;
 };
 
 #endif
@@ -102,6 +102,7 @@ void RS_Insert::update() {
         }
 
     clear();
+    blockStamp = 0;
 
     RS_Block* blk = getBlockForInsert();
 	if (!blk) {
@@ -132,6 +133,12 @@ void RS_Insert::update() {
         RS_DEBUG->print("RS_Insert::update: block has %d entities",
                 blk->count());
 //int i_en_counts=0;
+        // update the inserts of the block once, not once per copy. This is
+        // a no-op if the block and its nested blocks didn't change
+        if (data.updateMode!=RS2::PreviewUpdate) {
+            blk->updateNestedInserts();
+        }
+
 		for(auto e: *blk){
         for (int c=0; c<data.cols; ++c) {
 //            RS_DEBUG->print("RS_Insert::update: col %d", c);
@@ -139,17 +146,22 @@ void RS_Insert::update() {
 //                i_en_counts++;
 //                RS_DEBUG->print("RS_Insert::update: row %d", r);
 
-                if (e->rtti()==RS2::EntityInsert &&
-                    data.updateMode!=RS2::PreviewUpdate) {
-
-//                                        RS_DEBUG->print("RS_Insert::update: updating sub-insert");
-					static_cast<RS_Insert*>(e)->update();
-                }
-
 //                                RS_DEBUG->print("RS_Insert::update: cloning entity");
 
                 RS_Entity* ne;
-                if ( (data.scaleFactor.x - data.scaleFactor.y)>1.0e-6) {
+                if (e->rtti()==RS2::EntityInsert && !e->isUndone()
+                        && static_cast<RS_Insert*>(e)->data.updateMode!=RS2::PreviewUpdate) {
+                    // nested inserts are regenerated below for their new
+                    // position, don't deep copy their current content
+                    RS_Insert* i = static_cast<RS_Insert*>(e);
+                    RS_InsertData d = i->getData();
+                    d.updateMode = RS2::NoUpdate;
+                    RS_Insert* ni = new RS_Insert(this, d);
+                    ni->block = i->block;
+                    ni->setLayer(e->getLayer());
+                    ni->setPen(e->getPen(false));
+                    ne = ni;
+                } else if ( (data.scaleFactor.x - data.scaleFactor.y)>1.0e-6) {
                     if (e->rtti()== RS2::EntityArc) {
 						RS_Arc* a= static_cast<RS_Arc*>(e);
 						ne = new RS_Ellipse{this,
@@ -244,6 +256,9 @@ void RS_Insert::update() {
         }
     }
     calculateBorders();
+    if (data.updateMode!=RS2::PreviewUpdate) {
+        blockStamp = blk->getDependencyStamp();
+    }
 
         RS_DEBUG->print("RS_Insert::update: OK");
 }
@@ -288,6 +303,16 @@ RS_Block* RS_Insert::getBlockForInsert() const{
 }
 
 
+/**
+ * @return true if the block of this insert or one of its nested blocks
+ * changed since the last update of this insert.
+ */
+bool RS_Insert::isBlockChanged() const {
+	RS_Block* blk = getBlockForInsert();
+	return !blk || blk->getDependencyStamp() != blockStamp;
+}
+
+
 /**
  * Is this insert visible? (re-implementation from RS_Entity)
  *
@@ -118,6 +118,7 @@ public:
 	RS_Block* getBlockForInsert() const;
 
     virtual void update();
+	bool isBlockChanged() const;
 
     QString getName() const {
         return data.name;
@@ -191,6 +192,8 @@ public:
 protected:
     RS_InsertData data;
 	mutable RS_Block* block;
+	//! dependency stamp of the block at the last update
+	unsigned long long blockStamp = 0;
 };
 
 
@@ -28,6 +28,7 @@
 #include <iostream>
 #include <QString>
 #include "rs_layer.h"
+#include "rs_entity.h"
 
 RS_LayerData::RS_LayerData(const QString& name,
 						   const RS_Pen& pen,
@@ -103,6 +104,7 @@ void RS_Layer::setConverted(bool c) {
 void RS_Layer::toggle() {
 	//toggleFlag(RS2::FlagFrozen);
 	data.frozen = !data.frozen;
+	RS_Entity::bumpVisibilitySerial();
 }
 
 /**
@@ -112,6 +114,7 @@ void RS_Layer::toggle() {
  */
 void RS_Layer::freeze(bool freeze) {
 	data.frozen = freeze;
+	RS_Entity::bumpVisibilitySerial();
 }
 
 /**
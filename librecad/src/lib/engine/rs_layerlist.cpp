@@ -29,6 +29,7 @@
 #include "rs_debug.h"
 #include "rs_layerlist.h"
 #include "rs_layer.h"
+#include "rs_entity.h"
 #include "rs_layerlistlistener.h"
 
 /**
@@ -230,6 +231,7 @@ void RS_LayerList::edit(RS_Layer* layer, const RS_Layer& source) {
     }
 
     *layer = source;
+    RS_Entity::bumpVisibilitySerial();
 
     for (int i=0; i<layerListListeners.size(); ++i) {
         RS_LayerListListener* l = layerListListeners.at(i);
@@ -112,14 +112,13 @@ void RS_Leader::update() {
 RS_Entity* RS_Leader::addVertex(const RS_Vector& v) {
 
 	RS_Entity* entity{nullptr};
-	static RS_Vector last = RS_Vector{false};
 
     if (empty) {
-        last = v;
+        lastVertex = v;
         empty = false;
     } else {
         // add line to the leader:
-		entity = new RS_Line{this, {last, v}};
+		entity = new RS_Line{this, {lastVertex, v}};
         entity->setPen(RS_Pen(RS2::FlagInvalid));
 		entity->setLayer(nullptr);
         RS_EntityContainer::addEntity(entity);
@@ -128,7 +127,7 @@ RS_Entity* RS_Leader::addVertex(const RS_Vector& v) {
                         update();
                 }
 
-        last = v;
+        lastVertex = v;
     }
 
     return entity;
@@ -104,6 +104,8 @@ public:
 protected:
 	RS_LeaderData data;
 	bool empty;
+	/** last vertex added, the start point of the next line */
+	RS_Vector lastVertex{false};
 };
 
 #endif
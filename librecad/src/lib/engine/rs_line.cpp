@@ -427,6 +427,10 @@ bool RS_Line::hasEndpointsWithinWindow(const RS_Vector& firstCorner, const RS_Ve
 
 }
 
+bool RS_Line::isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const {
+	return LC_Rect{v1, v2}.intersectsSegment(data.startpoint, data.endpoint);
+}
+
 /**
   * this function creates offset
   *@coord, position indicates the direction of offset
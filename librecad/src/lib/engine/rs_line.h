@@ -136,6 +136,7 @@ public:
         calculateBorders();
     }
     bool hasEndpointsWithinWindow(const RS_Vector& v1, const RS_Vector& v2) override;
+	bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const override;
 
     /**
      * @return The length of the line.
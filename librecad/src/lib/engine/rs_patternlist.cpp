@@ -74,15 +74,17 @@ RS_Pattern* RS_PatternList::requestPattern(const QString& name) {
     QString name2 = name.toLower();
 
 	RS_DEBUG->print("name2: %s", name2.toLatin1().data());
-	if (patterns.count(name2)) {
-		if (!patterns[name2]) {
+	// find() only, so requesting loaded patterns concurrently is safe
+	auto it = patterns.find(name2);
+	if (it != patterns.end()) {
+		if (!it->second) {
 			RS_Pattern* p = new RS_Pattern(name2);
 			p->loadPattern();
-			patterns[name2].reset(p);
+			it->second.reset(p);
 		}
 		RS_DEBUG->print("name2: %s, size= %d", name2.toLatin1().data(),
-						patterns[name2]->countDeep());
-		return patterns[name2].get();
+						it->second->countDeep());
+		return it->second.get();
 	}
 
 	return nullptr;
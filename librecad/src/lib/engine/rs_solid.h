@@ -143,7 +143,7 @@ public:
     /** Check if is intersected by v1, v2 window.
     * @return true if is crossed false otherwise.
     **/
-    bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const;
+    bool isInCrossWindow(const RS_Vector& v1, const RS_Vector& v2) const override;
 
 protected:
     RS_SolidData data;
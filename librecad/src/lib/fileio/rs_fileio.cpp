@@ -38,6 +38,7 @@
 #include "rs_filterjww.h"
 #include "rs_filterlff.h"
 #include "rs_filterdxfrw.h"
+#include "lc_filtersnapshot.h"
 #include "rs_debug.h"
 
 /**
@@ -98,6 +99,30 @@ bool RS_FileIO::fileImport(RS_Graphic& graphic, const QString& file,
 }
 
 
+bool RS_FileIO::fileProbe(RS_Graphic& graphic, const QString& file,
+        std::map<QString, int>* entityCounts, RS2::FormatType type) {
+
+    RS_DEBUG->print("Probing file '%s'...", file.toLatin1().data());
+
+    RS2::FormatType t = (type == RS2::FormatUnknown) ? detectFormat(file) : type;
+    if (RS2::FormatUnknown == t) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "RS_FileIO::fileProbe: failed to detect file format: %s",
+                        file.toLatin1().data());
+        return false;
+    }
+
+    std::unique_ptr<RS_FilterInterface> filter(getImportFilter(file, t));
+    if (!filter || !filter->fileProbe(graphic, file, t, entityCounts)) {
+        RS_DEBUG->print(RS_Debug::D_WARNING,
+                        "RS_FileIO::fileProbe: failed to probe file: %s",
+                        file.toLatin1().data());
+        return false;
+    }
+    return true;
+}
+
+
 /** \brief extension2Type convert extension to file format type
  * \param file type
  * \param verifyRead read the file to verify dxf/dxfrw type, default to false
@@ -109,7 +134,8 @@ RS2::FormatType RS_FileIO::detectFormat(QString const& file, bool forRead)
 	std::map<QString, RS2::FormatType> list{
 		{"dxf", RS2::FormatDXFRW},
 		{"cxf", RS2::FormatCXF},
-		{"lff", RS2::FormatLFF}
+		{"lff", RS2::FormatLFF},
+		{LC_FilterSnapshot::extension(), RS2::FormatSnapshot}
 	};
 	// only read support for dwg
 	if(forRead) list["dwg"]=RS2::FormatDWG;
@@ -131,6 +157,10 @@ RS2::FormatType RS_FileIO::detectFormat(QString const& file, bool forRead)
 							__func__,
 							file.toLatin1().data());
 			type = RS2::FormatUnknown;
+		} else if (f.peek(18) == "AutoCAD Binary DXF") {
+			// sentinel of binary DXF files
+			type = RS2::FormatDXFRWBinary;
+			f.close();
 		} else {
 			RS_DEBUG->print("%s:"
 							"Successfully opened DXF file: %s",
@@ -229,6 +259,7 @@ std::vector<std::function<RS_FilterInterface*()>> RS_FileIO::getFilters()
 												  ,RS_FilterCXF::createFilter
 												  ,RS_FilterJWW::createFilter
 												  ,RS_FilterDXF1::createFilter
+												  ,LC_FilterSnapshot::createFilter
 												  };
 }
 
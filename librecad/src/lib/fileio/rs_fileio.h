@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <functional>
+#include <map>
 #include <memory>
 #include "rs_filterinterface.h"
 
@@ -70,6 +71,18 @@ public:
 		
     bool fileExport(RS_Graphic& graphic, const QString& file,
 		RS2::FormatType type = RS2::FormatUnknown);
+
+	/**
+	 * \brief fileProbe reads only header variables and tables of a file,
+	 * e.g. $EXTMIN/$EXTMAX, units and layers, much faster than fileImport()
+	 * for large DXF files. DWG files are still read and decompressed as a
+	 * whole, see RS_FilterInterface::fileProbe(). No messages are shown.
+	 * \param entityCounts if not null, the entities are counted per type (DXF only)
+	 * \return false if the file can't be read or probing isn't supported
+	 */
+	bool fileProbe(RS_Graphic& graphic, const QString& file,
+		std::map<QString, int>* entityCounts = nullptr,
+		RS2::FormatType type = RS2::FormatUnknown);
 	/** \brief detectFormat detect file format type
 	 * \param file type
 	 * \param forRead read the file to verify dxf/dxfrw type, default to true
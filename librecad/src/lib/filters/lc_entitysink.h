@@ -0,0 +1,47 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_ENTITYSINK_H
+#define LC_ENTITYSINK_H
+
+class RS_Entity;
+
+/**
+ * Receiver of the model space entities of a streaming import, see
+ * RS_FilterDXFRW::setEntitySink().
+ *
+ * Layers, blocks and header variables still go to the graphic, so that
+ * inserts and attributes resolve as usual, but the model space stays
+ * empty and memory use doesn't grow with the number of entities.
+ */
+class LC_EntitySink {
+public:
+	virtual ~LC_EntitySink() = default;
+
+	/**
+	 * @brief addEntity called once per model space entity, in file order.
+	 * The entity is updated and its parent chain leads to the graphic. It
+	 * is deleted after the call, clone it to keep it.
+	 */
+	virtual void addEntity(RS_Entity* entity) = 0;
+};
+
+#endif // LC_ENTITYSINK_H
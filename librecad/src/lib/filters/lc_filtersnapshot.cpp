@@ -0,0 +1,972 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <limits>
+#include <vector>
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+
+#include "lc_filtersnapshot.h"
+#include "lc_polylineoffset.h"
+#include "lc_splinepoints.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_debug.h"
+#include "rs_dimaligned.h"
+#include "rs_dimangular.h"
+#include "rs_dimdiametric.h"
+#include "rs_dimlinear.h"
+#include "rs_dimradial.h"
+#include "rs_ellipse.h"
+#include "rs_hatch.h"
+#include "rs_image.h"
+#include "rs_insert.h"
+#include "rs_layer.h"
+#include "rs_leader.h"
+#include "rs_line.h"
+#include "rs_mtext.h"
+#include "rs_point.h"
+#include "rs_polyline.h"
+#include "rs_solid.h"
+#include "rs_spline.h"
+#include "rs_text.h"
+
+namespace {
+
+// "LCSN", followed by the version of the layout below
+constexpr quint32 snapshotMagic = 0x4C43534E;
+constexpr quint32 snapshotVersion = 1;
+
+enum SnapshotError {
+	NoError,
+	FileError,
+	FormatError,
+	VersionError,
+	DataError
+};
+
+void setupStream(QDataStream& stream)
+{
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream.setByteOrder(QDataStream::LittleEndian);
+	stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+}
+
+QDataStream& operator << (QDataStream& out, const RS_Vector& v)
+{
+	return out << v.valid << v.x << v.y;
+}
+
+QDataStream& operator >> (QDataStream& in, RS_Vector& v)
+{
+	return in >> v.valid >> v.x >> v.y;
+}
+
+template <typename T>
+void writeList(QDataStream& out, const std::vector<T>& list)
+{
+	out << quint32(list.size());
+	for (const T& item: list)
+		out << item;
+}
+
+template <typename T>
+void readList(QDataStream& in, std::vector<T>& list)
+{
+	quint32 count = 0;
+	in >> count;
+	list.clear();
+	for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+		T item{};
+		in >> item;
+		list.push_back(item);
+	}
+}
+
+void writePen(QDataStream& out, const RS_Pen& pen)
+{
+	const RS_Color& color = pen.getColor();
+	out << quint32(color.rgb()) << quint32(color.getFlags())
+		<< qint32(pen.getWidth()) << qint32(pen.getLineType()) << quint32(pen.getFlags());
+}
+
+RS_Pen readPen(QDataStream& in)
+{
+	quint32 rgb = 0, colorFlags = 0, penFlags = 0;
+	qint32 width = 0, lineType = 0;
+	in >> rgb >> colorFlags >> width >> lineType >> penFlags;
+	RS_Color color(qRed(rgb), qGreen(rgb), qBlue(rgb));
+	color.setFlags(colorFlags);
+	RS_Pen pen(color, RS2::LineWidth(width), RS2::LineType(lineType));
+	pen.setFlags(penFlags);
+	return pen;
+}
+
+void writeDimensionData(QDataStream& out, const RS_DimensionData& d)
+{
+	out << quint32(d.getFlags()) << d.definitionPoint << d.middleOfText
+		<< qint32(d.valign) << qint32(d.halign) << qint32(d.lineSpacingStyle)
+		<< d.lineSpacingFactor << d.text << d.style << d.angle;
+}
+
+RS_DimensionData readDimensionData(QDataStream& in)
+{
+	RS_DimensionData d;
+	quint32 flags = 0;
+	qint32 valign = 0, halign = 0, lineSpacingStyle = 0;
+	in >> flags >> d.definitionPoint >> d.middleOfText
+	   >> valign >> halign >> lineSpacingStyle
+	   >> d.lineSpacingFactor >> d.text >> d.style >> d.angle;
+	d.setFlags(flags);
+	d.valign = RS_MTextData::VAlign(valign);
+	d.halign = RS_MTextData::HAlign(halign);
+	d.lineSpacingStyle = RS_MTextData::MTextLineSpacingStyle(lineSpacingStyle);
+	return d;
+}
+
+/** @return true for the entity types stored in snapshots */
+bool isStored(const RS_Entity* e)
+{
+	switch (e->rtti()) {
+	case RS2::EntityContainer:
+	case RS2::EntityPoint:
+	case RS2::EntityLine:
+	case RS2::EntityCircle:
+	case RS2::EntityArc:
+	case RS2::EntityEllipse:
+	case RS2::EntitySolid:
+	case RS2::EntityPolyline:
+	case RS2::EntitySpline:
+	case RS2::EntitySplinePoints:
+	case RS2::EntityInsert:
+	case RS2::EntityText:
+	case RS2::EntityMText:
+	case RS2::EntityHatch:
+	case RS2::EntityImage:
+	case RS2::EntityDimAligned:
+	case RS2::EntityDimLinear:
+	case RS2::EntityDimRadial:
+	case RS2::EntityDimDiametric:
+	case RS2::EntityDimAngular:
+	case RS2::EntityDimLeader:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Writes a graphic, see SnapshotReader for the layout.
+ */
+class SnapshotWriter {
+public:
+	explicit SnapshotWriter(QDataStream& out):
+		out(out)
+	{}
+
+	void write(RS_Graphic& g)
+	{
+		out << snapshotMagic << snapshotVersion << g.getMin() << g.getMax();
+		writeVariables(g);
+		writeLayers(g);
+
+		RS_BlockList* blocks = g.getBlockList();
+		out << quint32(blocks->count());
+		for (RS_Block* block: *blocks) {
+			out << block->getName() << block->getBasePoint() << block->isFrozen();
+			writeEntities(*block);
+		}
+
+		writeEntities(g);
+	}
+
+private:
+	void writeVariables(RS_Graphic& g)
+	{
+		const QHash<QString, RS_Variable>& variables = g.getVariableDict();
+		out << quint32(variables.size());
+		for (auto it = variables.cbegin(); it != variables.cend(); ++it) {
+			const RS_Variable& v = it.value();
+			out << it.key() << qint32(v.getType()) << qint32(v.getCode());
+			switch (v.getType()) {
+			case RS2::VariableString:
+				out << v.getString();
+				break;
+			case RS2::VariableInt:
+				out << qint32(v.getInt());
+				break;
+			case RS2::VariableDouble:
+				out << v.getDouble();
+				break;
+			case RS2::VariableVector:
+				out << v.getVector();
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void writeLayers(RS_Graphic& g)
+	{
+		RS_LayerList* layerList = g.getLayerList();
+		out << quint32(layerList->count());
+		for (RS_Layer* layer: *layerList) {
+			layers.insert(layer, layers.size());
+			out << layer->getName();
+			writePen(out, layer->getPen());
+			out << layer->isFrozen() << layer->isLocked() << layer->isPrint()
+				<< layer->isConverted() << layer->isConstruction();
+		}
+		RS_Layer* active = g.getActiveLayer();
+		out << (active ? active->getName() : QString());
+	}
+
+	void writeEntities(const RS_EntityContainer& container)
+	{
+		// undone entities and generated ones, as hatch patterns, are left out
+		std::vector<RS_Entity*> entities;
+		for (RS_Entity* e: container) {
+			if (!e->isUndone() && !e->getFlag(RS2::FlagTemp) && isStored(e))
+				entities.push_back(e);
+		}
+		out << quint32(entities.size());
+		for (RS_Entity* e: entities)
+			writeEntity(e);
+	}
+
+	void writeEntity(RS_Entity* e)
+	{
+		out << qint32(e->rtti()) << qint32(layers.value(e->getLayer(false), -1));
+		writePen(out, e->getPen(false));
+
+		switch (e->rtti()) {
+		case RS2::EntityContainer:
+			writeEntities(*static_cast<RS_EntityContainer*>(e));
+			break;
+		case RS2::EntityPoint:
+			out << static_cast<RS_Point*>(e)->getData().pos;
+			break;
+		case RS2::EntityLine: {
+			const RS_LineData d = static_cast<RS_Line*>(e)->getData();
+			out << d.startpoint << d.endpoint;
+			break;
+		}
+		case RS2::EntityCircle: {
+			const RS_CircleData& d = static_cast<RS_Circle*>(e)->getData();
+			out << d.center << d.radius;
+			break;
+		}
+		case RS2::EntityArc: {
+			const RS_ArcData d = static_cast<RS_Arc*>(e)->getData();
+			out << d.center << d.radius << d.angle1 << d.angle2 << d.reversed;
+			break;
+		}
+		case RS2::EntityEllipse: {
+			const RS_EllipseData& d = static_cast<RS_Ellipse*>(e)->getData();
+			out << d.center << d.majorP << d.ratio << d.angle1 << d.angle2 << d.reversed;
+			break;
+		}
+		case RS2::EntitySolid:
+			for (const RS_Vector& corner: static_cast<RS_Solid*>(e)->getData().corner)
+				out << corner;
+			break;
+		case RS2::EntityPolyline: {
+			RS_Polyline* polyline = static_cast<RS_Polyline*>(e);
+			const LC_PolylineOffset::Path path = LC_PolylineOffset::fromPolyline(*polyline);
+			out << path.closed << quint32(path.vertices.size());
+			for (const auto& vertex: path.vertices)
+				out << vertex.first << vertex.second;
+			break;
+		}
+		case RS2::EntitySpline: {
+			const RS_SplineData& d = static_cast<RS_Spline*>(e)->getData();
+			out << quint32(d.degree) << d.closed;
+			writeList(out, d.controlPoints);
+			writeList(out, d.knotslist);
+			break;
+		}
+		case RS2::EntitySplinePoints: {
+			const LC_SplinePointsData& d = static_cast<LC_SplinePoints*>(e)->getData();
+			out << d.closed << d.cut;
+			writeList(out, d.splinePoints);
+			writeList(out, d.controlPoints);
+			break;
+		}
+		case RS2::EntityInsert: {
+			const RS_InsertData d = static_cast<RS_Insert*>(e)->getData();
+			out << d.name << d.insertionPoint << d.scaleFactor << d.angle
+				<< qint32(d.cols) << qint32(d.rows) << d.spacing;
+			break;
+		}
+		case RS2::EntityText: {
+			const RS_TextData d = static_cast<RS_Text*>(e)->getData();
+			out << d.insertionPoint << d.secondPoint << d.height << d.widthRel
+				<< qint32(d.valign) << qint32(d.halign) << qint32(d.textGeneration)
+				<< d.text << d.style << d.angle;
+			break;
+		}
+		case RS2::EntityMText: {
+			const RS_MTextData d = static_cast<RS_MText*>(e)->getData();
+			out << d.insertionPoint << d.height << d.width
+				<< qint32(d.valign) << qint32(d.halign)
+				<< qint32(d.drawingDirection) << qint32(d.lineSpacingStyle)
+				<< d.lineSpacingFactor << d.text << d.style << d.angle;
+			break;
+		}
+		case RS2::EntityHatch: {
+			RS_Hatch* hatch = static_cast<RS_Hatch*>(e);
+			const RS_HatchData d = hatch->getData();
+			out << d.solid << d.scale << d.angle << d.pattern;
+			// the loops, the pattern is generated again
+			writeEntities(*hatch);
+			break;
+		}
+		case RS2::EntityImage: {
+			const RS_ImageData d = static_cast<RS_Image*>(e)->getData();
+			out << qint32(d.handle) << d.insertionPoint << d.uVector << d.vVector << d.size
+				<< d.file << qint32(d.brightness) << qint32(d.contrast) << qint32(d.fade);
+			break;
+		}
+		case RS2::EntityDimAligned: {
+			RS_DimAligned* dim = static_cast<RS_DimAligned*>(e);
+			writeDimensionData(out, dim->getData());
+			out << dim->getEData().extensionPoint1 << dim->getEData().extensionPoint2;
+			break;
+		}
+		case RS2::EntityDimLinear: {
+			RS_DimLinear* dim = static_cast<RS_DimLinear*>(e);
+			const RS_DimLinearData ed = dim->getEData();
+			writeDimensionData(out, dim->getData());
+			out << ed.extensionPoint1 << ed.extensionPoint2 << ed.angle << ed.oblique;
+			break;
+		}
+		case RS2::EntityDimRadial: {
+			RS_DimRadial* dim = static_cast<RS_DimRadial*>(e);
+			const RS_DimRadialData ed = dim->getEData();
+			writeDimensionData(out, dim->getData());
+			out << ed.definitionPoint << ed.leader;
+			break;
+		}
+		case RS2::EntityDimDiametric: {
+			RS_DimDiametric* dim = static_cast<RS_DimDiametric*>(e);
+			const RS_DimDiametricData ed = dim->getEData();
+			writeDimensionData(out, dim->getData());
+			out << ed.definitionPoint << ed.leader;
+			break;
+		}
+		case RS2::EntityDimAngular: {
+			RS_DimAngular* dim = static_cast<RS_DimAngular*>(e);
+			const RS_DimAngularData ed = dim->getEData();
+			writeDimensionData(out, dim->getData());
+			out << ed.definitionPoint1 << ed.definitionPoint2
+				<< ed.definitionPoint3 << ed.definitionPoint4;
+			break;
+		}
+		case RS2::EntityDimLeader: {
+			RS_Leader* leader = static_cast<RS_Leader*>(e);
+			// vertices as in RS_FilterDXFRW::writeLeader()
+			std::vector<RS_Vector> vertices;
+			RS_Entity* last = nullptr;
+			for (RS_Entity* v: *leader) {
+				if (v->rtti() == RS2::EntityLine) {
+					vertices.push_back(v->getStartpoint());
+					last = v;
+				}
+			}
+			if (last)
+				vertices.push_back(last->getEndpoint());
+			out << leader->getData().arrowHead;
+			writeList(out, vertices);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	QDataStream& out;
+	QHash<RS_Layer*, int> layers;
+};
+
+/**
+ * Reads a graphic from a snapshot:
+ * - magic number, version and the extents of the drawing
+ * - header variables with their type and group code
+ * - layers with pen and flags, then the name of the active layer
+ * - blocks with their entities
+ * - model space entities
+ *
+ * Entities are stored as type, layer index, pen and the values of their
+ * data struct. Hatches and anonymous containers (hatch loops) are followed
+ * by their children.
+ *
+ * Without generate, no geometry is generated and no fonts, patterns or
+ * images are loaded, only the data needed to export the drawing again.
+ * Images are only loaded with loadImages.
+ */
+class SnapshotReader {
+public:
+	SnapshotReader(QDataStream& in, RS_Graphic& g, bool generate, bool loadImages):
+		in(in)
+	  , graphic(g)
+	  , generate(generate)
+	  , loadImages(loadImages)
+	{}
+
+	/** @return error code of SnapshotError */
+	int readHeader(RS_Vector& min, RS_Vector& max)
+	{
+		quint32 magic = 0, version = 0;
+		in >> magic >> version;
+		if (in.status() != QDataStream::Ok || magic != snapshotMagic)
+			return FormatError;
+		if (version != snapshotVersion)
+			return VersionError;
+		in >> min >> max;
+		return in.status() == QDataStream::Ok ? NoError : DataError;
+	}
+
+	bool readTables()
+	{
+		readVariables();
+		readLayers();
+		return in.status() == QDataStream::Ok;
+	}
+
+	bool readEntities()
+	{
+		quint32 count = 0;
+		in >> count;
+		for (quint32 i = 0; i < count && ok(); ++i) {
+			QString name;
+			RS_Vector basePoint{false};
+			bool frozen = false;
+			in >> name >> basePoint >> frozen;
+			RS_Block* block = new RS_Block(&graphic, RS_BlockData(name, basePoint, frozen));
+			if (graphic.addBlock(block, false)) {
+				readEntities(block);
+			} else {
+				// duplicate, read past its entities
+				RS_Block skipped(nullptr, RS_BlockData(name, basePoint, frozen));
+				std::vector<RS_Entity*> unused;
+				std::swap(unused, pendingUpdates);
+				readEntities(&skipped);
+				std::swap(unused, pendingUpdates);
+			}
+		}
+		graphic.addBlockNotification();
+
+		readEntities(&graphic);
+		return ok();
+	}
+
+	/**
+	 * @brief finish updates the entities with generated geometry, the
+	 * same way as after reading a DXF file
+	 */
+	void finish()
+	{
+		RS_Layer* active = graphic.findLayer(activeLayer);
+		if (active)
+			graphic.getLayerList()->activate(active, true);
+		if (generate)
+			graphic.updateEntities(pendingUpdates);
+		pendingUpdates.clear();
+	}
+
+private:
+	bool ok() const
+	{
+		return !failed && in.status() == QDataStream::Ok;
+	}
+
+	void readVariables()
+	{
+		quint32 count = 0;
+		in >> count;
+		for (quint32 i = 0; i < count && ok(); ++i) {
+			QString key;
+			qint32 type = 0, code = 0;
+			in >> key >> type >> code;
+			switch (type) {
+			case RS2::VariableString: {
+				QString value;
+				in >> value;
+				graphic.addVariable(key, value, code);
+				break;
+			}
+			case RS2::VariableInt: {
+				qint32 value = 0;
+				in >> value;
+				graphic.addVariable(key, int(value), code);
+				break;
+			}
+			case RS2::VariableDouble: {
+				double value = 0.;
+				in >> value;
+				graphic.addVariable(key, value, code);
+				break;
+			}
+			case RS2::VariableVector: {
+				RS_Vector value{false};
+				in >> value;
+				graphic.addVariable(key, value, code);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+
+	void readLayers()
+	{
+		quint32 count = 0;
+		in >> count;
+		for (quint32 i = 0; i < count && ok(); ++i) {
+			QString name;
+			in >> name;
+			RS_Layer* layer = new RS_Layer(name);
+			layer->setPen(readPen(in));
+			bool frozen = false, locked = false, print = true, converted = false, construction = false;
+			in >> frozen >> locked >> print >> converted >> construction;
+			layer->freeze(frozen);
+			layer->lock(locked);
+			layer->setPrint(print);
+			layer->setConverted(converted);
+			layer->setConstruction(construction);
+			// an existing layer of the same name takes the attributes and stays
+			graphic.addLayer(layer);
+			layers.push_back(graphic.findLayer(name));
+		}
+		in >> activeLayer;
+	}
+
+	void readEntities(RS_EntityContainer* container)
+	{
+		quint32 count = 0;
+		in >> count;
+		for (quint32 i = 0; i < count && ok(); ++i) {
+			RS_Entity* e = readEntity(container);
+			if (e)
+				container->addEntity(e);
+		}
+	}
+
+	/**
+	 * @return the entity with parent container, nullptr for invalid
+	 * hatches and unknown entity types, which fail the import
+	 */
+	RS_Entity* readEntity(RS_EntityContainer* parent)
+	{
+		qint32 type = 0, layer = -1;
+		in >> type >> layer;
+		RS_Pen pen = readPen(in);
+
+		RS_Entity* e = nullptr;
+		switch (type) {
+		case RS2::EntityContainer: {
+			RS_EntityContainer* container = new RS_EntityContainer(parent);
+			readEntities(container);
+			e = container;
+			break;
+		}
+		case RS2::EntityPoint: {
+			RS_Vector pos{false};
+			in >> pos;
+			e = new RS_Point(parent, RS_PointData(pos));
+			break;
+		}
+		case RS2::EntityLine: {
+			RS_LineData d;
+			in >> d.startpoint >> d.endpoint;
+			e = new RS_Line(parent, d);
+			break;
+		}
+		case RS2::EntityCircle: {
+			RS_CircleData d;
+			in >> d.center >> d.radius;
+			e = new RS_Circle(parent, d);
+			break;
+		}
+		case RS2::EntityArc: {
+			RS_ArcData d;
+			in >> d.center >> d.radius >> d.angle1 >> d.angle2 >> d.reversed;
+			e = new RS_Arc(parent, d);
+			break;
+		}
+		case RS2::EntityEllipse: {
+			RS_EllipseData d;
+			in >> d.center >> d.majorP >> d.ratio >> d.angle1 >> d.angle2 >> d.reversed;
+			e = new RS_Ellipse(parent, d);
+			break;
+		}
+		case RS2::EntitySolid: {
+			RS_SolidData d;
+			for (RS_Vector& corner: d.corner)
+				in >> corner;
+			e = new RS_Solid(parent, d);
+			break;
+		}
+		case RS2::EntityPolyline: {
+			bool closed = false;
+			quint32 count = 0;
+			in >> closed >> count;
+			std::vector<std::pair<RS_Vector, double>> vertices;
+			for (quint32 i = 0; i < count && ok(); ++i) {
+				RS_Vector vertex{false};
+				double bulge = 0.;
+				in >> vertex >> bulge;
+				vertices.emplace_back(vertex, bulge);
+			}
+			// as RS_FilterDXFRW::addLWPolyline()
+			RS_Polyline* polyline = new RS_Polyline(parent, RS_PolylineData(RS_Vector{}, RS_Vector{}, closed));
+			polyline->appendVertexs(vertices);
+			e = polyline;
+			break;
+		}
+		case RS2::EntitySpline: {
+			quint32 degree = 0;
+			bool closed = false;
+			in >> degree >> closed;
+			RS_SplineData d(int(degree), closed);
+			readList(in, d.controlPoints);
+			readList(in, d.knotslist);
+			RS_Spline* spline = new RS_Spline(parent, d);
+			if (generate)
+				spline->update();
+			e = spline;
+			break;
+		}
+		case RS2::EntitySplinePoints: {
+			bool closed = false, cut = false;
+			in >> closed >> cut;
+			LC_SplinePointsData d(closed, cut);
+			readList(in, d.splinePoints);
+			readList(in, d.controlPoints);
+			LC_SplinePoints* splinePoints = new LC_SplinePoints(parent, d);
+			if (generate)
+				splinePoints->update();
+			e = splinePoints;
+			break;
+		}
+		case RS2::EntityInsert: {
+			RS_InsertData d;
+			qint32 cols = 1, rows = 1;
+			in >> d.name >> d.insertionPoint >> d.scaleFactor >> d.angle
+			   >> cols >> rows >> d.spacing;
+			d.cols = cols;
+			d.rows = rows;
+			d.blockSource = nullptr;
+			// updated with all inserts at the end
+			d.updateMode = RS2::NoUpdate;
+			e = new RS_Insert(parent, d);
+			break;
+		}
+		case RS2::EntityText: {
+			RS_TextData d;
+			qint32 valign = 0, halign = 0, textGeneration = 0;
+			in >> d.insertionPoint >> d.secondPoint >> d.height >> d.widthRel
+			   >> valign >> halign >> textGeneration
+			   >> d.text >> d.style >> d.angle;
+			d.valign = RS_TextData::VAlign(valign);
+			d.halign = RS_TextData::HAlign(halign);
+			d.textGeneration = RS_TextData::TextGeneration(textGeneration);
+			d.updateMode = RS2::NoUpdate;
+			e = new RS_Text(parent, d);
+			pendingUpdates.push_back(e);
+			break;
+		}
+		case RS2::EntityMText: {
+			RS_MTextData d;
+			qint32 valign = 0, halign = 0, drawingDirection = 0, lineSpacingStyle = 0;
+			in >> d.insertionPoint >> d.height >> d.width
+			   >> valign >> halign >> drawingDirection >> lineSpacingStyle
+			   >> d.lineSpacingFactor >> d.text >> d.style >> d.angle;
+			d.valign = RS_MTextData::VAlign(valign);
+			d.halign = RS_MTextData::HAlign(halign);
+			d.drawingDirection = RS_MTextData::MTextDrawingDirection(drawingDirection);
+			d.lineSpacingStyle = RS_MTextData::MTextLineSpacingStyle(lineSpacingStyle);
+			d.updateMode = RS2::NoUpdate;
+			e = new RS_MText(parent, d);
+			pendingUpdates.push_back(e);
+			break;
+		}
+		case RS2::EntityHatch: {
+			RS_HatchData d;
+			in >> d.solid >> d.scale >> d.angle >> d.pattern;
+			RS_Hatch* hatch = new RS_Hatch(parent, d);
+			readEntities(hatch);
+			if (!ok() || !hatch->validate()) {
+				RS_DEBUG->print(RS_Debug::D_WARNING,
+								"LC_FilterSnapshot: dropping invalid hatch");
+				delete hatch;
+				return nullptr;
+			}
+			pendingUpdates.push_back(hatch);
+			e = hatch;
+			break;
+		}
+		case RS2::EntityImage: {
+			RS_ImageData d;
+			qint32 handle = 0, brightness = 0, contrast = 0, fade = 0;
+			in >> handle >> d.insertionPoint >> d.uVector >> d.vVector >> d.size
+			   >> d.file >> brightness >> contrast >> fade;
+			d.handle = handle;
+			d.brightness = brightness;
+			d.contrast = contrast;
+			d.fade = fade;
+			if (loadImages) {
+				// loads the image file
+				e = new RS_Image(parent, d);
+			} else {
+				QString const file = d.file;
+				d.file.clear();
+				RS_Image* image = new RS_Image(parent, d);
+				image->setFile(file);
+				e = image;
+			}
+			break;
+		}
+		case RS2::EntityDimAligned: {
+			const RS_DimensionData d = readDimensionData(in);
+			RS_DimAlignedData ed;
+			in >> ed.extensionPoint1 >> ed.extensionPoint2;
+			e = new RS_DimAligned(parent, d, ed);
+			break;
+		}
+		case RS2::EntityDimLinear: {
+			const RS_DimensionData d = readDimensionData(in);
+			RS_DimLinearData ed;
+			in >> ed.extensionPoint1 >> ed.extensionPoint2 >> ed.angle >> ed.oblique;
+			e = new RS_DimLinear(parent, d, ed);
+			break;
+		}
+		case RS2::EntityDimRadial: {
+			const RS_DimensionData d = readDimensionData(in);
+			RS_DimRadialData ed;
+			in >> ed.definitionPoint >> ed.leader;
+			e = new RS_DimRadial(parent, d, ed);
+			break;
+		}
+		case RS2::EntityDimDiametric: {
+			const RS_DimensionData d = readDimensionData(in);
+			RS_DimDiametricData ed;
+			in >> ed.definitionPoint >> ed.leader;
+			e = new RS_DimDiametric(parent, d, ed);
+			break;
+		}
+		case RS2::EntityDimAngular: {
+			const RS_DimensionData d = readDimensionData(in);
+			RS_DimAngularData ed;
+			in >> ed.definitionPoint1 >> ed.definitionPoint2
+			   >> ed.definitionPoint3 >> ed.definitionPoint4;
+			e = new RS_DimAngular(parent, d, ed);
+			break;
+		}
+		case RS2::EntityDimLeader: {
+			bool arrowHead = false;
+			std::vector<RS_Vector> vertices;
+			in >> arrowHead;
+			readList(in, vertices);
+			RS_Leader* leader = new RS_Leader(parent, RS_LeaderData(arrowHead));
+			for (const RS_Vector& vertex: vertices)
+				leader->addVertex(vertex);
+			e = leader;
+			break;
+		}
+		default:
+			RS_DEBUG->print(RS_Debug::D_WARNING,
+							"LC_FilterSnapshot: unknown entity type %d", type);
+			failed = true;
+			return nullptr;
+		}
+
+		e->setLayer(layer >= 0 && layer < int(layers.size()) ? layers[layer] : nullptr);
+		e->setPen(pen);
+		// dimensions and leaders build their geometry with layer and pen
+		switch (generate ? type : RS2::EntityUnknown) {
+		case RS2::EntityDimAligned:
+		case RS2::EntityDimLinear:
+		case RS2::EntityDimRadial:
+		case RS2::EntityDimDiametric:
+		case RS2::EntityDimAngular:
+		case RS2::EntityDimLeader:
+			e->update();
+			break;
+		default:
+			break;
+		}
+		return e;
+	}
+
+	QDataStream& in;
+	RS_Graphic& graphic;
+	std::vector<RS_Layer*> layers;
+	QString activeLayer;
+	std::vector<RS_Entity*> pendingUpdates;
+	bool const generate;
+	bool const loadImages;
+	bool failed = false;
+};
+
+}
+
+const char* LC_FilterSnapshot::extension()
+{
+	return "lcsnap";
+}
+
+bool LC_FilterSnapshot::fileImport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/)
+{
+	RS_DEBUG->print("LC_FilterSnapshot::fileImport: '%s'", QFile::encodeName(file).data());
+	return readFile(g, file, ReadMode::Import);
+}
+
+/**
+ * Reads the header variables and the layers, the extents of the drawing
+ * are stored as $EXTMIN and $EXTMAX. Entities aren't counted.
+ */
+bool LC_FilterSnapshot::fileProbe(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/,
+								  std::map<QString, int>* /*entityCounts*/)
+{
+	return readFile(g, file, ReadMode::Probe);
+}
+
+bool LC_FilterSnapshot::readFile(RS_Graphic& g, const QString& file, ReadMode mode)
+{
+	QFile f(file);
+	if (!f.open(QIODevice::ReadOnly)) {
+		errorCode = FileError;
+		return false;
+	}
+
+	// read from the mapped file where possible, QByteArray is limited to int
+	QBuffer buffer;
+	QIODevice* device = &f;
+	qint64 const size = f.size();
+	if (size <= std::numeric_limits<int>::max()) {
+		uchar* mapped = f.map(0, size);
+		if (mapped) {
+			buffer.setData(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), int(size)));
+			buffer.open(QIODevice::ReadOnly);
+			device = &buffer;
+		}
+	}
+
+	errorCode = read(g, *device, mode);
+	if (errorCode == DataError)
+		RS_DEBUG->print(RS_Debug::D_WARNING,
+						"LC_FilterSnapshot: corrupt snapshot '%s'",
+						QFile::encodeName(file).data());
+	return errorCode == NoError;
+}
+
+int LC_FilterSnapshot::read(RS_Graphic& g, QIODevice& device, ReadMode mode)
+{
+	QDataStream in(&device);
+	setupStream(in);
+
+	SnapshotReader reader(in, g, mode == ReadMode::Import || mode == ReadMode::Export,
+						  mode == ReadMode::Import);
+	RS_Vector min{false}, max{false};
+	int const error = reader.readHeader(min, max);
+	if (error != NoError)
+		return error;
+	if (!reader.readTables())
+		return DataError;
+	if (mode == ReadMode::Probe) {
+		if (min.valid && max.valid) {
+			g.addVariable("$EXTMIN", min, 10);
+			g.addVariable("$EXTMAX", max, 10);
+		}
+		return NoError;
+	}
+
+	bool const success = reader.readEntities();
+	// entities read so far stay, as with a truncated DXF file
+	reader.finish();
+	return success ? NoError : DataError;
+}
+
+bool LC_FilterSnapshot::fileExport(RS_Graphic& g, const QString& file, RS2::FormatType /*type*/)
+{
+	RS_DEBUG->print("LC_FilterSnapshot::fileExport: '%s'", QFile::encodeName(file).data());
+	bool const success = writeFile(file, serialize(g));
+	errorCode = success ? NoError : FileError;
+	return success;
+}
+
+QByteArray LC_FilterSnapshot::serialize(RS_Graphic& g)
+{
+	QByteArray data;
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::WriteOnly);
+	QDataStream out(&buffer);
+	setupStream(out);
+	SnapshotWriter(out).write(g);
+	return data;
+}
+
+bool LC_FilterSnapshot::deserialize(RS_Graphic& g, const QByteArray& data, bool generate)
+{
+	QBuffer buffer;
+	buffer.setData(data);
+	buffer.open(QIODevice::ReadOnly);
+	return read(g, buffer, generate ? ReadMode::Export : ReadMode::DataOnly) == NoError;
+}
+
+bool LC_FilterSnapshot::writeFile(const QString& file, const QByteArray& data)
+{
+	// the previous file stays intact until the new one is complete
+	QSaveFile f(file);
+	if (!f.open(QIODevice::WriteOnly))
+		return false;
+	if (f.write(data) != data.size()) {
+		f.cancelWriting();
+		return false;
+	}
+	return f.commit();
+}
+
+QString LC_FilterSnapshot::lastError() const
+{
+	switch (errorCode) {
+	case NoError:
+		return QObject::tr("no error", "LC_FilterSnapshot");
+	case FileError:
+		return QObject::tr("error opening or writing the snapshot file", "LC_FilterSnapshot");
+	case FormatError:
+		return QObject::tr("not a LibreCAD snapshot", "LC_FilterSnapshot");
+	case VersionError:
+		return QObject::tr("snapshot of another LibreCAD version", "LC_FilterSnapshot");
+	case DataError:
+		return QObject::tr("corrupt snapshot", "LC_FilterSnapshot");
+	default:
+		return RS_FilterInterface::lastError();
+	}
+}
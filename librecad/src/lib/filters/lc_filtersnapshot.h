@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#ifndef LC_FILTERSNAPSHOT_H
+#define LC_FILTERSNAPSHOT_H
+
+#include "rs_filterinterface.h"
+
+class QIODevice;
+
+/**
+ * Imports and exports LibreCAD snapshots (*.lcsnap), a versioned binary
+ * dump of a drawing: header variables, layers, blocks and the entities
+ * with their pens, stored as the values of their data structs.
+ *
+ * Nothing is parsed or converted on import. The file is memory mapped
+ * and the entities are created directly from the stored data, only the
+ * generated geometry of inserts, texts, hatches and dimensions is built
+ * again. The extents of the drawing are stored in the header, so probing
+ * reads just the header, the variables and the layers.
+ *
+ * The format isn't meant for exchange, other versions of LibreCAD may
+ * refuse it. Auto save writes a snapshot next to the auto save file for
+ * fast recovery.
+ */
+class LC_FilterSnapshot : public RS_FilterInterface {
+public:
+	LC_FilterSnapshot() = default;
+
+	bool canImport(const QString& /*fileName*/, RS2::FormatType t) const override {
+		return t == RS2::FormatSnapshot;
+	}
+
+	bool canExport(const QString& /*fileName*/, RS2::FormatType t) const override {
+		return t == RS2::FormatSnapshot;
+	}
+
+	bool fileImport(RS_Graphic& g, const QString& file, RS2::FormatType type) override;
+	bool fileExport(RS_Graphic& g, const QString& file, RS2::FormatType type) override;
+	bool fileProbe(RS_Graphic& g, const QString& file, RS2::FormatType type,
+				   std::map<QString, int>* entityCounts) override;
+	QString lastError() const override;
+
+	static RS_FilterInterface* createFilter() {
+		return new LC_FilterSnapshot();
+	}
+
+	/** file name extension of snapshots, without the dot */
+	static const char* extension();
+
+	/** @return the snapshot of g, as written by fileExport() */
+	static QByteArray serialize(RS_Graphic& g);
+
+	/**
+	 * @brief deserialize reads a snapshot into g, for a graphic no other
+	 * thread uses. Images are not loaded, the result is good for
+	 * exporting, not for display.
+	 *
+	 * Without generate, dimensions, texts and hatches stay empty and no
+	 * fonts or patterns are needed. With generate, their geometry is
+	 * regenerated as after an import. The fonts and patterns they use must
+	 * be loaded already to do this on a worker thread, see
+	 * RS_Graphic::loadResources().
+	 */
+	static bool deserialize(RS_Graphic& g, const QByteArray& data, bool generate = false);
+
+	/**
+	 * @brief writeFile writes data to file, an existing file is replaced
+	 * only once data is written completely
+	 */
+	static bool writeFile(const QString& file, const QByteArray& data);
+
+private:
+	enum class ReadMode {
+		Probe,   //!< header, variables and layers
+		Import,  //!< everything, with generated geometry
+		DataOnly, //!< everything, without generated geometry
+		Export   //!< everything, with generated geometry but without images
+	};
+
+	bool readFile(RS_Graphic& g, const QString& file, ReadMode mode);
+	/** @return error code, 0 on success */
+	static int read(RS_Graphic& g, QIODevice& device, ReadMode mode);
+};
+
+#endif // LC_FILTERSNAPSHOT_H
@@ -24,10 +24,12 @@
 **********************************************************************/
 
 #include<cstdlib>
+#include <memory>
 #include <QStringList>
 #include <QTextCodec>
 
 #include "rs_filterdxfrw.h"
+#include "lc_entitysink.h"
 
 #include "rs_arc.h"
 #include "rs_circle.h"
@@ -60,6 +62,59 @@
 #include "rs_debug.h"
 #endif
 
+namespace {
+/**
+ * Model space of streaming imports. An entity is handed on to the sink
+ * once the next one arrives, when the filter is done with it, images
+ * wait for the end of the file, where their files are linked.
+ */
+class StreamContainer : public RS_EntityContainer {
+public:
+    StreamContainer(RS_Graphic* graphic, LC_EntitySink& sink, std::vector<RS_Entity*>& blockUpdates):
+        RS_EntityContainer(graphic, true)
+      , graphic(graphic)
+      , sink(sink)
+      , blockUpdates(blockUpdates)
+    {
+        RS_EntityContainer::setAutoUpdateBorders(false);
+    }
+
+    void addEntity(RS_Entity* entity) override {
+        deliver(false);
+        RS_EntityContainer::addEntity(entity);
+    }
+
+    void appendEntity(RS_Entity* entity) override {
+        deliver(false);
+        RS_EntityContainer::appendEntity(entity);
+    }
+
+    void deliver(bool all) {
+        // inserts are updated from blocks, which are complete by now
+        if (!blockUpdates.empty()) {
+            graphic->updateEntities(blockUpdates);
+            blockUpdates.clear();
+        }
+        QList<RS_Entity*> kept;
+        for (RS_Entity* e: entities) {
+            if (!all && e->rtti() == RS2::EntityImage) {
+                kept.append(e);
+                continue;
+            }
+            e->update();
+            sink.addEntity(e);
+            delete e;
+        }
+        entities = kept;
+    }
+
+private:
+    RS_Graphic* graphic;
+    LC_EntitySink& sink;
+    std::vector<RS_Entity*>& blockUpdates;
+};
+}
+
 /**
  * Default constructor.
  *
@@ -148,8 +203,13 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
 #endif
 
     graphic = &g;
-    currentContainer = graphic;
+    std::unique_ptr<StreamContainer> stream;
+    if (entitySink)
+        stream.reset(new StreamContainer(graphic, *entitySink, pendingUpdates));
+    modelSpace = stream ? stream.get() : static_cast<RS_EntityContainer*>(graphic);
+    currentContainer = modelSpace;
 	dummyContainer = new RS_EntityContainer(nullptr, true);
+    pendingUpdates.clear();
 
     this->file = file;
     // add some variables that need to be there for DXF drawings:
@@ -167,15 +227,19 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file");
         if (RS_DEBUG->getLevel()== RS_Debug::D_DEBUGGING)
             dwgr.setDebug(DRW::DebugLevel::Debug);
-        bool success = dwgr.read(this, true);
+        bool success = probing ? dwgr.probe(this) : dwgr.read(this, true);
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading DWG file: OK");
-        RS_DIALOGFACTORY->commandMessage(QObject::tr("Opened dwg file version %1.").arg(printDwgVersion(dwgr.getVersion())));
+        if (!probing)
+            RS_DIALOGFACTORY->commandMessage(QObject::tr("Opened dwg file version %1.").arg(printDwgVersion(dwgr.getVersion())));
         int  lastError = dwgr.getError();
         if (false == success) {
-            printDwgError(lastError);
+            if (!probing)
+                printDwgError(lastError);
             RS_DEBUG->print(RS_Debug::D_WARNING,
                             "Cannot open DWG file '%s'.", (const char*)QFile::encodeName(file));
             errorCode = dwgr.getError();
+            pendingUpdates.clear();
+            modelSpace = graphic;
             return false;
         }
     } else {
@@ -183,7 +247,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
         dxfRW dxfR(QFile::encodeName(file));
 
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading file");
-        bool success = dxfR.read(this, true);
+        bool success = probing ? dxfR.probe(this, probeCounts) : dxfR.read(this, true);
         RS_DEBUG->print("RS_FilterDXFRW::fileImport: reading file: OK");
         //graphic->setAutoUpdateBorders(true);
 
@@ -191,6 +255,8 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
             RS_DEBUG->print(RS_Debug::D_WARNING,
                             "Cannot open DXF file '%s'.", (const char*)QFile::encodeName(file));
             errorCode = dxfR.getError();
+            pendingUpdates.clear();
+            modelSpace = graphic;
             return false;
         }
 #ifdef DWGSUPPORT
@@ -204,14 +270,46 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
         //require to notify
         graphic->getLayerList()->activate(cl, true);
     }
-    RS_DEBUG->print("RS_FilterDXFRW::fileImport: updating inserts");
-    graphic->updateInserts();
+    RS_DEBUG->print("RS_FilterDXFRW::fileImport: updating entities and inserts");
+    if (stream)
+        stream->deliver(true);
+    graphic->updateEntities(pendingUpdates);
+    pendingUpdates.clear();
+    modelSpace = graphic;
 
     RS_DEBUG->print("RS_FilterDXFRW::fileImport OK");
 
     return true;
 }
 
+/**
+ * Reads header variables, layers and other tables of the file into g,
+ * blocks and entities are skipped. For DXF files the entities are
+ * counted per type into entityCounts, if not null.
+ */
+bool RS_FilterDXFRW::fileProbe(RS_Graphic& g, const QString& file, RS2::FormatType type,
+                               std::map<QString, int>* entityCounts) {
+    RS_DEBUG->print("RS_FilterDXFRW::fileProbe");
+    std::map<std::string, int> counts;
+    probing = true;
+    probeCounts = entityCounts ? &counts : nullptr;
+    bool success = fileImport(g, file, type);
+    probing = false;
+    probeCounts = nullptr;
+
+    if (entityCounts) {
+        for (auto const& c: counts)
+            (*entityCounts)[QString::fromStdString(c.first)] += c.second;
+    }
+    return success;
+}
+
+void RS_FilterDXFRW::setEntitySink(LC_EntitySink* sink) {
+    entitySink = sink;
+}
+
+
+
 /**
  * Implementation of the method which handles layers.
  */
@@ -342,7 +440,7 @@ void RS_FilterDXFRW::addBlock(const DRW_Block& data) {
                 blockHash.insert(data.parentHandle, dummyContainer);
     } else {
         if (mid.toLower() == "model_space") {
-            blockHash.insert(data.parentHandle, graphic);
+            blockHash.insert(data.parentHandle, modelSpace);
         } else {
             blockHash.insert(data.parentHandle, dummyContainer);
         }
@@ -354,7 +452,7 @@ void RS_FilterDXFRW::setBlock(const int handle){
     if (blockHash.contains(handle)) {
         currentContainer = blockHash.value(handle);
     } else
-        currentContainer = graphic;
+        currentContainer = modelSpace;
 }
 
 /**
@@ -369,7 +467,7 @@ void RS_FilterDXFRW::endBlock() {
                 graphic->removeBlock(bk);
         }
     }
-    currentContainer = graphic;
+    currentContainer = modelSpace;
 }
 
 
@@ -778,7 +876,7 @@ void RS_FilterDXFRW::addMText(const DRW_MText& data) {
     RS_MText* entity = new RS_MText(currentContainer, d);
 
     setEntityAttributes(entity, &data);
-    entity->update();
+    deferUpdate(entity);
     currentContainer->addEntity(entity);
 }
 
@@ -837,7 +935,7 @@ void RS_FilterDXFRW::addText(const DRW_Text& data) {
     RS_Text* entity = new RS_Text(currentContainer, d);
 
     setEntityAttributes(entity, &data);
-    entity->update();
+    deferUpdate(entity);
     currentContainer->addEntity(entity);
 }
 
@@ -1192,9 +1290,9 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
 
     RS_DEBUG->print("hatch->update()");
     if (hatch->validate()) {
-        hatch->update();
+        deferUpdate(hatch);
     } else {
-        graphic->removeEntity(hatch);
+        currentContainer->removeEntity(hatch);
         RS_DEBUG->print(RS_Debug::D_ERROR,
                     "RS_FilterDXFRW::endEntity(): updating hatch failed: invalid hatch area");
     }
@@ -1257,8 +1355,8 @@ void RS_FilterDXFRW::linkImage(const DRW_ImageDef *data) {
     }
 
     // Also link images in subcontainers (e.g. inserts):
-    for (RS_Entity* e=graphic->firstEntity(RS2::ResolveNone);
-            e; e=graphic->nextEntity(RS2::ResolveNone)) {
+    for (RS_Entity* e=modelSpace->firstEntity(RS2::ResolveNone);
+            e; e=modelSpace->nextEntity(RS2::ResolveNone)) {
         if (e->rtti()==RS2::EntityImage) {
             RS_Image* img = (RS_Image*)e;
             if (img->getHandle()==handle) {
@@ -1294,8 +1392,8 @@ using std::map;
  */
 void RS_FilterDXFRW::addHeader(const DRW_Header* data){
 	RS_Graphic* container = nullptr;
-    if (currentContainer->rtti()==RS2::EntityGraphic) {
-        container = (RS_Graphic*)currentContainer;
+    if (currentContainer == modelSpace) {
+        container = graphic;
     } else return;
 
     for (auto it = data->vars.begin() ; it != data->vars.end(); ++it ) {
@@ -1414,8 +1512,7 @@ bool RS_FilterDXFRW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatT
     }
 
     dxfW = new dxfRW(QFile::encodeName(file));
-    bool success = dxfW->write(this, exportVersion, false); //ascii
-//    bool success = dxf->write(this, exportVersion, true); //binary
+    bool success = dxfW->write(this, exportVersion, type==RS2::FormatDXFRWBinary);
     delete dxfW;
 
     if (!success) {
@@ -2993,6 +3090,22 @@ void RS_FilterDXFRW::writeImage(RS_Image * i) {
 }*/
 
 
+/**
+ * Updates the entity after the whole file is read, see
+ * RS_Graphic::updateEntities(). Entities which are not kept are
+ * updated right away.
+ */
+void RS_FilterDXFRW::deferUpdate(RS_Entity* entity) {
+    if (currentContainer == dummyContainer) {
+        entity->update();
+    } else if (currentContainer != modelSpace || modelSpace == graphic) {
+        // streamed entities are updated when handed on
+        pendingUpdates.push_back(entity);
+    }
+}
+
+
+
 /**
  * Sets the entities attributes according to the attributes
  * that come from a DXF file.
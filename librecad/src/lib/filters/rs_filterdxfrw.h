@@ -27,6 +27,7 @@
 #ifndef RS_FILTERDXFRW_H
 #define RS_FILTERDXFRW_H
 
+#include <vector>
 #include "rs_filterinterface.h"
 
 #include "rs_color.h"
@@ -51,6 +52,7 @@ class RS_Image;
 class RS_Leader;
 class RS_Polyline;
 class DL_WriterA;
+class LC_EntitySink;
 
 /**
  * This format filter class can import and export DXF files.
@@ -65,15 +67,15 @@ public:
         
     virtual bool canImport(const QString &/*fileName*/, RS2::FormatType t) const override {
 #ifdef DWGSUPPORT
-        return (t==RS2::FormatDXFRW || t==RS2::FormatDWG);
+        return (t==RS2::FormatDXFRW || t==RS2::FormatDXFRWBinary || t==RS2::FormatDWG);
 #else
-        return (t==RS2::FormatDXFRW);
+        return (t==RS2::FormatDXFRW || t==RS2::FormatDXFRWBinary);
 #endif
         }
         
     virtual bool canExport(const QString &/*fileName*/, RS2::FormatType t) const override {
         return (t==RS2::FormatDXFRW || t==RS2::FormatDXFRW2004 || t==RS2::FormatDXFRW2000
-                || t==RS2::FormatDXFRW14 || t==RS2::FormatDXFRW12);
+                || t==RS2::FormatDXFRW14 || t==RS2::FormatDXFRW12 || t==RS2::FormatDXFRWBinary);
     }
 
     // Error messages
@@ -81,6 +83,15 @@ public:
 
     // Import:
     virtual bool fileImport(RS_Graphic& g, const QString& file, RS2::FormatType type) override;
+    /** entity counts are for DXF files only */
+    virtual bool fileProbe(RS_Graphic& g, const QString& file, RS2::FormatType type,
+                           std::map<QString, int>* entityCounts) override;
+
+    /**
+     * Streams the model space entities of following imports to sink
+     * instead of adding them to the graphic, nullptr for normal imports.
+     */
+    void setEntitySink(LC_EntitySink* sink);
 
     // Methods from DRW_CreationInterface:
     virtual void addHeader(const DRW_Header* data) override;
@@ -168,6 +179,7 @@ public:
 	
 
     void setEntityAttributes(RS_Entity* entity, const DRW_Entity* attrib);
+    void deferUpdate(RS_Entity* entity);
     void getEntityAttributes(DRW_Entity* ent, const RS_Entity* entity);
 
     static QString toDxfString(const QString& str);
@@ -209,8 +221,15 @@ private:
     RS_Graphic* graphic;
     /** File name. Used to find out the full path of images. */
     QString file;
-    /** Pointer to current entity container (either block or graphic) */
+    /** Pointer to current entity container (either block or model space) */
     RS_EntityContainer* currentContainer;
+    /** Container of model space entities, the graphic unless streaming */
+    RS_EntityContainer* modelSpace {nullptr};
+    /** Receiver of model space entities for streaming imports */
+    LC_EntitySink* entitySink {nullptr};
+    /** Read only header and tables, see fileProbe() */
+    bool probing {false};
+    std::map<std::string, int>* probeCounts {nullptr};
     /** File codePage. Used to find the text coder. */
     QString codePage;
     /** File version. */
@@ -235,6 +254,8 @@ private:
     QHash<int, RS_EntityContainer*> blockHash;
     /** Pointer to entity container to store possible orphan entities like paper space */
     RS_EntityContainer* dummyContainer;
+    /** Texts and hatches to update once the whole file is read */
+    std::vector<RS_Entity*> pendingUpdates;
 };
 
 #endif
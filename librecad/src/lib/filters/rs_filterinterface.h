@@ -29,6 +29,8 @@
 #ifndef RS_FILTERINTERFACE_H
 #define RS_FILTERINTERFACE_H
 
+#include <map>
+
 #include "rs_graphic.h"
 
 #include <QObject>
@@ -83,6 +85,24 @@ public:
      */
     virtual bool fileExport(RS_Graphic& g, const QString& file, RS2::FormatType type) = 0;
 
+    /**
+     * Reads only the header variables and tables (layers, styles) of a
+     * file into the graphic, without its entities. Filters supporting it
+     * count the entities per type into entityCounts, if not null.
+     *
+     * DXF files stop being parsed after the tables, unless entities are
+     * counted. DWG files are still read completely and their objects
+     * section is decompressed, because the table records are objects of
+     * that section. Only blocks and entities are not parsed, so probing
+     * a DWG file saves less than probing a DXF file.
+     *
+     * @return false if the file can't be read or the filter doesn't support probing.
+     */
+    virtual bool fileProbe(RS_Graphic& /*g*/, const QString& /*file*/, RS2::FormatType /*type*/,
+                           std::map<QString, int>* /*entityCounts*/) {
+        return false;
+    }
+
     /**
      * Request the error message for the last import/export action, based on member variable \p errorCode.
      * The default implementation is for existing filters, inherited without error handling methods.
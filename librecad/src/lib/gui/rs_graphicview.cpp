@@ -41,6 +41,7 @@
 #include "rs_eventhandler.h"
 #include "rs_graphic.h"
 #include "rs_grid.h"
+#include "lc_snapcache.h"
 #include "rs_painter.h"
 #include "rs_mtext.h"
 #include "rs_text.h"
@@ -64,6 +65,7 @@ RS_GraphicView::RS_GraphicView(QWidget* parent, Qt::WindowFlags f)
 	,gridColor(Qt::gray)
 	,metaGridColor{64, 64, 64}
 	,grid{new RS_Grid{this}}
+	,snapCache{new LC_SnapCache{}}
 	,drawingMode(RS2::ModeFull)
 	,savedViews(16)
     ,previousViewTime(QDateTime::currentDateTime())
@@ -99,6 +101,7 @@ void RS_GraphicView::cleanUp() {
  */
 void RS_GraphicView::setContainer(RS_EntityContainer* container) {
 	this->container = container;
+	snapCache->clear();
 	//adjustOffsetControls();
 }
 
@@ -1481,9 +1484,9 @@ void RS_GraphicView::drawGrid(RS_Painter *painter) {
 	painter->setPen(gridColor);
 
 	//grid->updatePointArray();
-	auto const& pts = grid->getPoints();
-	for(auto const& v: pts){
-		painter->drawGridPoint(toGui(v));
+	LC_PointBuffer const& pts = grid->getGuiPoints();
+	for (size_t i = 0; i < pts.size(); ++i) {
+		painter->drawGridPoint(pts.at(i));
 	}
 
 	// draw grid info:
@@ -1755,6 +1758,10 @@ RS_EntityContainer* RS_GraphicView::getOverlayContainer(RS2::OverlayGraphics pos
 
 }
 
+LC_SnapCache* RS_GraphicView::getSnapCache() const{
+	return snapCache.get();
+}
+
 RS_Grid* RS_GraphicView::getGrid() const{
 	return grid.get();
 }
@@ -45,6 +45,7 @@ class RS_ActionInterface;
 class RS_EventHandler;
 class RS_CommandEvent;
 class RS_Grid;
+class LC_SnapCache;
 struct RS_LineTypePattern;
 
 
@@ -285,6 +286,7 @@ public:
 	virtual void drawOverlay(RS_Painter *painter);
 
 	RS_Grid* getGrid() const;
+	LC_SnapCache* getSnapCache() const;
     virtual void updateGridStatusWidget(const QString& /*text*/) = 0;
 
 	void setDefaultSnapMode(RS_SnapMode sm);
@@ -407,6 +409,8 @@ protected:
 	RS_Color endHandleColor;
 	/** Grid */
 	std::unique_ptr<RS_Grid> grid;
+	/** Snap point cache shared by the actions of this view */
+	std::unique_ptr<LC_SnapCache> snapCache;
 	/**
 		 * Current default snap mode for this graphic view. Used for new
 		 * actions.
@@ -103,7 +103,9 @@ void RS_Grid::updatePointArray() {
 
 	// std::cout<<"Grid userGrid="<<userGrid<<std::endl;
 
-	pt.clear();
+	// the points are rebuilt only if the lattices of the grid change
+	std::vector<Lattice> previous;
+	previous.swap(lattices);
 	metaX.clear();
 	metaY.clear();
 
@@ -178,6 +180,13 @@ void RS_Grid::updatePointArray() {
 		// RS_DEBUG->print("RS_Grid::update: 015");
 	}
 
+	if (lattices != previous) {
+		pt.clear();
+		for (Lattice const& l: lattices)
+			pt.appendLattice(l.origin, l.stepX, l.stepY, l.countX, l.countY);
+		++generation;
+	}
+
 	// RS_DEBUG->print("RS_Grid::update: OK");
 }
 
@@ -383,18 +392,8 @@ void RS_Grid::createOrthogonalGrid(LC_Rect const& rect, RS_Vector const& gridWid
 
 	if (number<=0 || number>maxGridPoints) return;
 
-	pt.resize(number);
-
-	int i=0;
-	RS_Vector bp0(baseGrid);
-	for (int y=0; y<numberY; ++y) {
-		RS_Vector bp1(bp0);
-		for (int x=0; x<numberX; ++x) {
-			pt[i++] = bp1;
-			bp1.x += gridWidth.x;
-		}
-		bp0.y += gridWidth.y;
-	}
+	lattices.push_back({baseGrid, {gridWidth.x, 0.}, {0., gridWidth.y},
+						static_cast<std::size_t>(numberX), static_cast<std::size_t>(numberY)});
 	// find meta grid boundaries
 	if (metaGridWidth.x>minimumGridWidth && metaGridWidth.y>minimumGridWidth &&
 			graphicView->toGuiDX(metaGridWidth.x)>2 &&
@@ -452,19 +451,10 @@ void RS_Grid::createIsometricGrid(LC_Rect const& rect, RS_Vector const& gridWidt
 
 	if (number<=0 || number>maxGridPoints) return;
 
-	pt.resize(number);
-
-	int i=0;
-	RS_Vector bp0(baseGrid),dbp1(hdx,hdy);
-	for (int y=0; y<numberY; ++y) {
-		RS_Vector bp1(bp0);
-		for (int x=0; x<numberX; ++x) {
-			pt[i++] = bp1;
-			pt[i++] = bp1+dbp1;
-			bp1.x += dx;
-		}
-		bp0.y += gridWidth.y;
-	}
+	lattices.push_back({baseGrid, {dx, 0.}, {0., gridWidth.y},
+						static_cast<std::size_t>(numberX), static_cast<std::size_t>(numberY)});
+	lattices.push_back({baseGrid + RS_Vector(hdx, hdy), {dx, 0.}, {0., gridWidth.y},
+						static_cast<std::size_t>(numberX), static_cast<std::size_t>(numberY)});
 	//find metaGrid
 	if (metaGridWidth.y>minimumGridWidth &&
 			graphicView->toGuiDY(metaGridWidth.y)>2) {
@@ -496,10 +486,50 @@ QString RS_Grid::getInfo() const{
 	return QString("%1 / %2").arg(spacing).arg(metaSpacing);
 }
 
-std::vector<RS_Vector> const& RS_Grid::getPoints() const{
+LC_PointBuffer const& RS_Grid::getPoints() const{
 	return pt;
 }
 
+LC_PointBuffer const& RS_Grid::getGuiPoints() {
+	// see RS_GraphicView::toGuiX() and toGuiY()
+	RS_Vector const factor = graphicView->getFactor();
+	GuiTransform const transform{generation, factor.x, factor.y,
+								 static_cast<double>(graphicView->getOffsetX()),
+								 static_cast<double>(graphicView->getHeight() - graphicView->getOffsetY())};
+	if (transform == guiTransform)
+		return guiPt;
+
+	// a lattice is a lattice on screen too
+	guiPt.clear();
+	guiPt.reserve(pt.size());
+	for (Lattice const& l: lattices) {
+		guiPt.appendLattice({factor.x*l.origin.x + transform.offsetX,
+							 -factor.y*l.origin.y + transform.offsetY},
+							{factor.x*l.stepX.x, -factor.y*l.stepX.y},
+							{factor.x*l.stepY.x, -factor.y*l.stepY.y},
+							l.countX, l.countY);
+	}
+	guiTransform = transform;
+	return guiPt;
+}
+
+bool RS_Grid::Lattice::operator == (Lattice const& other) const {
+	return origin.x == other.origin.x && origin.y == other.origin.y
+			&& stepX.x == other.stepX.x && stepX.y == other.stepX.y
+			&& stepY.x == other.stepY.x && stepY.y == other.stepY.y
+			&& countX == other.countX && countY == other.countY;
+}
+
+bool RS_Grid::Lattice::operator != (Lattice const& other) const {
+	return !(*this == other);
+}
+
+bool RS_Grid::GuiTransform::operator == (GuiTransform const& other) const {
+	return generation == other.generation
+			&& factorX == other.factorX && factorY == other.factorY
+			&& offsetX == other.offsetX && offsetY == other.offsetY;
+}
+
 std::vector<double> const& RS_Grid::getMetaX() const{
 	return metaX;
 }
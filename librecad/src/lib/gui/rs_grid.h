@@ -28,6 +28,7 @@
 #ifndef RS_GRID_H
 #define RS_GRID_H
 
+#include "lc_pointbuffer.h"
 #include "rs_vector.h"
 
 class RS_GraphicView;
@@ -57,7 +58,13 @@ public:
 	/**
 		 * @return Array of all visible grid points.
 		 */
-	std::vector<RS_Vector> const& getPoints() const;
+	LC_PointBuffer const& getPoints() const;
+
+	/**
+		 * @return All visible grid points in screen coordinates. Cached
+		 * until the grid points or the view transform change.
+		 */
+	LC_PointBuffer const& getGuiPoints();
 
 	/**
 	* \brief the closest grid point
@@ -115,8 +122,35 @@ private:
 	//! Current meta grid spacing
 	double metaSpacing;
 
-	//! Pointer to array of grid points
-	std::vector<RS_Vector> pt;
+	//! origin + i*stepX + j*stepY, i < countX, j < countY
+	struct Lattice {
+		RS_Vector origin;
+		RS_Vector stepX;
+		RS_Vector stepY;
+		std::size_t countX;
+		std::size_t countY;
+		bool operator == (Lattice const& other) const;
+		bool operator != (Lattice const& other) const;
+	};
+	//! the grid points are made of these lattices
+	std::vector<Lattice> lattices;
+	//! increased whenever the grid points change
+	unsigned long long generation = 0;
+	//! Array of grid points
+	LC_PointBuffer pt;
+
+	//! the view transform guiPt was built for
+	struct GuiTransform {
+		unsigned long long generation = 0;
+		double factorX = 0.;
+		double factorY = 0.;
+		double offsetX = 0.;
+		double offsetY = 0.;
+		bool operator == (GuiTransform const& other) const;
+	};
+	GuiTransform guiTransform;
+	//! grid points in screen coordinates
+	LC_PointBuffer guiPt;
 	RS_Vector baseGrid; // the left-bottom grid point
 	RS_Vector cellV;// (dx,dy)
 	RS_Vector metaGridWidth;
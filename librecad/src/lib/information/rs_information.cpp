@@ -25,6 +25,9 @@
 **
 **********************************************************************/
 
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
 #include <vector>
 #include "rs_information.h"
 #include "rs_entitycontainer.h"
@@ -40,8 +43,73 @@
 #include "lc_splinepoints.h"
 #include "rs_math.h"
 #include "lc_rect.h"
+#include "lc_broadphase.h"
+#include "lc_parallel.h"
 #include "rs_debug.h"
 
+namespace {
+/**
+ * An atomic entity taking part in RS_Information::getIntersections()
+ */
+struct IntersectionLeaf {
+	RS_Entity* entity;
+	std::size_t source;
+	// owning polyline and segment index, used to skip segment joints
+	RS_Polyline const* polyline;
+	int segment;
+};
+
+void collectIntersectionLeaves(RS_Entity* e, std::size_t source,
+							   std::vector<IntersectionLeaf>& leaves)
+{
+	if (!(e && e->isVisible()))
+		return;
+	switch (e->rtti()) {
+	case RS2::EntityText:
+	case RS2::EntityMText:
+	case RS2::EntityHatch:
+		return;
+	default:
+		if (RS_Information::isDimension(e->rtti()))
+			return;
+		break;
+	}
+
+	if (!e->isContainer()) {
+		leaves.push_back({e, source, nullptr, 0});
+		return;
+	}
+
+	if (e->rtti() == RS2::EntityPolyline) {
+		auto* polyline = static_cast<RS_Polyline*>(e);
+		int segment = 0;
+		for (RS_Entity* child: *polyline) {
+			if (child && child->isVisible())
+				leaves.push_back({child, source, polyline, segment});
+			++segment;
+		}
+		return;
+	}
+
+	for (RS_Entity* child: *static_cast<RS_EntityContainer*>(e))
+		collectIntersectionLeaves(child, source, leaves);
+}
+
+/**
+ * @return true, if leaves are consecutive segments of the same polyline
+ */
+bool isPolylineJoint(const IntersectionLeaf& a, const IntersectionLeaf& b)
+{
+	if (!a.polyline || a.polyline != b.polyline)
+		return false;
+	int const diff = std::abs(a.segment - b.segment);
+	if (diff == 1)
+		return true;
+	int const last = static_cast<int>(a.polyline->count()) - 1;
+	return a.polyline->isClosed() && last > 1 && diff == last;
+}
+}
+
 /**
  * Default constructor.
  *
@@ -253,7 +321,12 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity const* e1,
 	if ( e1->getParent() && e1->getParent() == e2->getParent()) {
         if ( e1->getParent()->rtti()==RS2::EntitySpline ) {
             //do not calculate intersections from neighboring lines of a spline
-            if ( abs(e1->getParent()->findEntity(e1) - e1->getParent()->findEntity(e2)) <= 1 ) {
+            // no findEntity() here, it moves the iteration index of the
+            // container and this method may be used from worker threads
+            RS_EntityContainer const& spline = *e1->getParent();
+            auto const it1 = std::find(spline.begin(), spline.end(), e1);
+            auto const it2 = std::find(spline.begin(), spline.end(), e2);
+            if ( std::abs(std::distance(it1, it2)) <= 1 ) {
                 return ret;
             }
         }
@@ -333,6 +406,85 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity const* e1,
 
 
 
+std::vector<RS_IntersectionData> RS_Information::getIntersections(
+		const std::vector<RS_Entity*>& entities, bool onEntities)
+{
+	std::vector<IntersectionLeaf> leaves;
+	for (std::size_t i = 0; i < entities.size(); ++i)
+		collectIntersectionLeaves(entities[i], i, leaves);
+
+	// construction entities are unbounded, they overlap everything
+	std::vector<LC_Rect> boxes;
+	boxes.reserve(leaves.size());
+	for (const IntersectionLeaf& leaf: leaves) {
+		if (leaf.entity->isConstruction())
+			boxes.emplace_back(RS_Vector{-RS_MAXDOUBLE, -RS_MAXDOUBLE},
+							   RS_Vector{RS_MAXDOUBLE, RS_MAXDOUBLE});
+		else
+			boxes.emplace_back(leaf.entity->getMin(), leaf.entity->getMax());
+	}
+	auto const pairs = LC_BroadPhase::overlappingPairs(boxes, RS_TOLERANCE);
+
+	RS_DEBUG->print("RS_Information::getIntersections: %d entities, %d candidate pairs",
+					static_cast<int>(leaves.size()), static_cast<int>(pairs.size()));
+
+	// results of each range, keyed by the first pair of the range
+	std::vector<std::pair<std::size_t, std::vector<RS_IntersectionData>>> ranges;
+	std::mutex rangesMutex;
+	LC_Parallel::forRange(pairs.size(), [&](std::size_t begin, std::size_t end) {
+		const double tol = 1.0e-4;
+		std::vector<RS_IntersectionData> found;
+		for (std::size_t k = begin; k < end; ++k) {
+			const IntersectionLeaf& a = leaves[pairs[k].first];
+			const IntersectionLeaf& b = leaves[pairs[k].second];
+			RS_VectorSolutions const sol = getIntersection(a.entity, b.entity, onEntities);
+			bool const joint = isPolylineJoint(a, b);
+			for (const RS_Vector& vp: sol) {
+				if (!vp.valid)
+					continue;
+				if (joint) {
+					auto atEnd = [&vp, tol](RS_Entity const* e) {
+						return vp.distanceTo(e->getStartpoint()) < tol
+								|| vp.distanceTo(e->getEndpoint()) < tol;
+					};
+					if (atEnd(a.entity) && atEnd(b.entity))
+						continue;
+				}
+				found.push_back({a.entity, b.entity, a.source, b.source, vp, sol.isTangent()});
+			}
+		}
+		std::lock_guard<std::mutex> lock(rangesMutex);
+		ranges.emplace_back(begin, std::move(found));
+	}, 64);
+
+	std::sort(ranges.begin(), ranges.end(),
+			  [](const std::pair<std::size_t, std::vector<RS_IntersectionData>>& lhs,
+				 const std::pair<std::size_t, std::vector<RS_IntersectionData>>& rhs) {
+		return lhs.first < rhs.first;
+	});
+	std::vector<RS_IntersectionData> ret;
+	for (auto& range: ranges)
+		ret.insert(ret.end(), range.second.begin(), range.second.end());
+	std::stable_sort(ret.begin(), ret.end(),
+					 [](const RS_IntersectionData& lhs, const RS_IntersectionData& rhs) {
+		return std::make_pair(lhs.source1, lhs.source2)
+				< std::make_pair(rhs.source1, rhs.source2);
+	});
+	return ret;
+}
+
+std::vector<RS_IntersectionData> RS_Information::getIntersections(
+		const RS_EntityContainer& container, bool selectedOnly)
+{
+	std::vector<RS_Entity*> entities;
+	for (RS_Entity* e: container) {
+		if (e && e->isVisible() && (!selectedOnly || e->isSelected()))
+			entities.push_back(e);
+	}
+	return getIntersections(entities, true);
+}
+
+
 /**
  * @return Intersection between two lines.
  */
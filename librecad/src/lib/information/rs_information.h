@@ -27,17 +27,32 @@
 #ifndef RS_INFORMATION_H
 #define RS_INFORMATION_H
 
+#include <cstddef>
+#include <vector>
 #include "rs.h"
+#include "rs_vector.h"
 
 class RS_Ellipse;
 class RS_Entity;
 class RS_EntityContainer;
-class RS_Vector;
-class RS_VectorSolutions;
 class RS_Arc;
 class RS_Circle;
 class RS_Line;
 
+/**
+ * One intersection found by RS_Information::getIntersections().
+ * entity1 and entity2 are the atomic entities which intersect, source1 and
+ * source2 are the indices of the input entities they belong to.
+ */
+struct RS_IntersectionData {
+	RS_Entity* entity1 = nullptr;
+	RS_Entity* entity2 = nullptr;
+	std::size_t source1 = 0;
+	std::size_t source2 = 0;
+	RS_Vector point;
+	bool tangent = false;
+};
+
 /**
  * Class for getting information about entities. This includes
  * also things like the end point of an element which is 
@@ -70,6 +85,30 @@ public:
 			RS_Entity const* e2,
             bool onEntities = false);
 
+	/**
+	 * @brief getIntersections all intersections between the given entities
+	 * Containers are resolved into their visible atomic entities, texts,
+	 * dimensions and hatches are ignored. Joint points of consecutive
+	 * polyline segments are not reported.
+	 * Candidate pairs are found by sweeping bounding boxes, the pairs are
+	 * solved concurrently. The result order does not depend on the number
+	 * of threads.
+	 * @param entities entities to intersect with each other
+	 * @param onEntities only report points on both entities
+	 * @return intersections, sorted by source1, source2
+	 */
+	static std::vector<RS_IntersectionData> getIntersections(
+			const std::vector<RS_Entity*>& entities,
+			bool onEntities = true);
+	/**
+	 * @brief getIntersections all intersections between the visible
+	 * entities of a container, see above
+	 * @param selectedOnly only use selected entities
+	 */
+	static std::vector<RS_IntersectionData> getIntersections(
+			const RS_EntityContainer& container,
+			bool selectedOnly = false);
+
     static RS_VectorSolutions getIntersectionLineLine(RS_Line* e1,
             RS_Line* e2);
 
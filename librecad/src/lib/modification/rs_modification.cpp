@@ -24,6 +24,9 @@
 **
 **********************************************************************/
 #include<cmath>
+#include <algorithm>
+#include <set>
+#include <unordered_map>
 #include <QSet>
 #include "rs_modification.h"
 
@@ -47,6 +50,9 @@
 #include "rs_debug.h"
 #include "rs_dialogfactory.h"
 #include "lc_undosection.h"
+#include "lc_parallel.h"
+#include "lc_polylineoffset.h"
+#include "lc_regionops.h"
 
 #ifdef EMU_C99
 #include "emu_c99.h"
@@ -100,15 +106,10 @@ void RS_Modification::remove() {
     }
 
     LC_UndoSection undo( document);
-	// not safe (?)
-    for(auto e: *container) {
-        if (e && e->isSelected()) {
-            e->setSelected(false);
-            e->changeUndoState();
-            undo.addUndoable(e);
-        } else {
-            RS_DEBUG->print(RS_Debug::D_WARNING, "RS_Modification::remove: no valid container is selected");
-        }
+    for(auto e: container->selectedEntities()) {
+        e->setSelected(false);
+        e->changeUndoState();
+        undo.addUndoable(e);
     }
 
     graphicView->redraw(RS2::RedrawDrawing);
@@ -131,7 +132,7 @@ void RS_Modification::revertDirection() {
 	}
 
 	std::vector<RS_Entity*> addList;
-    for(auto e: *container) {
+    for(auto e: container->selectedEntities()) {
 		if (e && e->isSelected()) {
 			RS_Entity* ec = e->clone();
 			ec->revertDirection();
@@ -170,7 +171,7 @@ bool RS_Modification::changeAttributes(
     QList<RS_Entity*> clones;
     QSet<RS_Block*> blocks;
 
-    for (auto en: *cont) {
+    for (auto en: cont->selectedEntities()) {
         if (!en) continue;
         if (!en->isSelected()) continue;
 
@@ -1595,7 +1596,7 @@ bool RS_Modification::move(RS_MoveData& data) {
         // too slow:
         //for (unsigned i=0; i<container->count(); ++i) {
 		//RS_Entity* e = container->entityAt(i);
-		for(auto e: *container){
+		for(auto e: container->selectedEntities()){
 			if (e && e->isSelected()) {
                 RS_Entity* ec = e->clone();
 
@@ -1637,14 +1638,69 @@ bool RS_Modification::offset(const RS_OffsetData& data) {
     }
 
 	std::vector<RS_Entity*> addList;
+	std::vector<RS_Entity*> const selection = container->selectedEntities();
+	size_t const passes = std::max(data.number, 1);
+
+	// polylines are offset as a whole, with the loops at concave corners
+	// removed. Lines and arcs connected to others are chained and offset
+	// like polylines. All paths and passes are independent.
+	std::vector<RS_Entity const*> sources;
+	std::vector<LC_PolylineOffset::Path> paths;
+	std::vector<double> sides;
+	std::vector<RS_Entity const*> segments;
+	for (RS_Entity* e: selection) {
+		if (!e || !e->isSelected())
+			continue;
+		if (e->rtti() == RS2::EntityPolyline) {
+			sources.push_back(e);
+			paths.push_back(LC_PolylineOffset::fromPolyline(*static_cast<RS_Polyline const*>(e)));
+		} else if (e->rtti() == RS2::EntityLine || e->rtti() == RS2::EntityArc) {
+			segments.push_back(e);
+		}
+	}
+	// same gap as in RS_ActionPolylineSegment
+	std::set<RS_Entity const*> chained;
+	for (LC_PolylineOffset::Chain& chain: LC_PolylineOffset::chains(segments, 1.0e-4)) {
+		sources.push_back(segments[chain.members.front()]);
+		paths.push_back(std::move(chain.path));
+		for (std::size_t i: chain.members)
+			chained.insert(segments[i]);
+	}
+	for (const LC_PolylineOffset::Path& path: paths)
+		sides.push_back(LC_PolylineOffset::side(path, data.coord));
+	std::vector<std::vector<LC_PolylineOffset::Path>> offsets(paths.size()*passes);
+	LC_Parallel::forRange(offsets.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			size_t const k = i/passes;
+			double const distance = sides[k]*(i%passes + 1)*data.distance;
+			offsets[i] = LC_PolylineOffset::offset(paths[k], distance);
+		}
+	});
 
     // Create new entities
     for (int num=1;
             num<=data.number || (data.number==0 && num<=1);
             num++) {
-        // too slow:
-		for(auto e: *container){
-			if (e && e->isSelected()) {
+		for (size_t k = 0; k < paths.size(); ++k) {
+			for (const LC_PolylineOffset::Path& path: offsets[k*passes + num - 1]) {
+				auto pl = new RS_Polyline(container, RS_PolylineData());
+				pl->setClosed(path.closed);
+				pl->appendVertexs(path.vertices);
+				pl->setLayer(sources[k]->getLayer());
+				pl->setPen(sources[k]->getPen(false));
+				if (data.useCurrentLayer) {
+					pl->setLayerToActive();
+				}
+				if (data.useCurrentAttributes) {
+					pl->setPenToActive();
+				}
+				pl->setSelected(true);
+				addList.push_back(pl);
+			}
+		}
+
+		for(auto e: selection){
+			if (e && e->isSelected() && e->rtti() != RS2::EntityPolyline && !chained.count(e)) {
                 RS_Entity* ec = e->clone();
 				//highlight is used by trim actions. do not carry over flag
 				ec->setHighlighted(false);
@@ -1695,7 +1751,7 @@ bool RS_Modification::rotate(RS_RotateData& data) {
     for (int num=1;
             num<=data.number || (data.number==0 && num<=1);
 			num++) {
-		for(auto e: *container){
+		for(auto e: container->selectedEntities()){
             //for (unsigned i=0; i<container->count(); ++i) {
             //RS_Entity* e = container->entityAt(i);
 
@@ -1823,7 +1879,7 @@ bool RS_Modification::mirror(RS_MirrorData& data) {
     for (int num=1;
             num<=(int)data.copy || (data.copy==false && num<=1);
 			++num) {
-		for(auto e: *container){
+		for(auto e: container->selectedEntities()){
             //for (unsigned i=0; i<container->count(); ++i) {
             //RS_Entity* e = container->entityAt(i);
 
@@ -1872,7 +1928,7 @@ bool RS_Modification::rotate2(RS_Rotate2Data& data) {
             num<=data.number || (data.number==0 && num<=1);
             num++) {
 
-		for(auto e: *container){
+		for(auto e: container->selectedEntities()){
             //for (unsigned i=0; i<container->count(); ++i) {
             //RS_Entity* e = container->entityAt(i);
 
@@ -1924,7 +1980,7 @@ bool RS_Modification::moveRotate(RS_MoveRotateData& data) {
     for (int num=1;
             num<=data.number || (data.number==0 && num<=1);
 			++num) {
-		for(auto e: *container){
+		for(auto e: container->selectedEntities()){
             //for (unsigned i=0; i<container->count(); ++i) {
             //RS_Entity* e = container->entityAt(i);
 
@@ -1967,44 +2023,11 @@ void RS_Modification::deselectOriginals(bool remove)
 {
     LC_UndoSection undo( document, handleUndo);
 
-    for (auto e: *container) {
-
-        //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
-
-        if (e) {
-            bool selected = false;
-
-            /*
-                  if (e->isAtomic()) {
-                      RS_AtomicEntity* ae = (RS_AtomicEntity*)e;
-                      if (ae->isStartpointSelected() ||
-                              ae->isEndpointSelected()) {
-
-                          selected = true;
-                      }
-                  }
-            */
-
-            if (e->isSelected()) {
-                selected = true;
-            }
-
-            if (selected) {
-                e->setSelected(false);
-                if (remove
-                   ) {
-                    //if (graphicView) {
-                    //    graphicView->deleteEntity(e);
-                    //}
-                    e->changeUndoState();
-                    undo.addUndoable(e);
-                } else {
-                    //if (graphicView) {
-                    //    graphicView->drawEntity(e);
-                    //}
-                }
-            }
+    for (auto e: container->selectedEntities()) {
+        e->setSelected(false);
+        if (remove) {
+            e->changeUndoState();
+            undo.addUndoable(e);
         }
     }
 }
@@ -2076,10 +2099,7 @@ bool RS_Modification::trim(const RS_Vector& trimCoord,
 
         //sol.alloc(128);
 
-        for (RS_Entity* e=ec->firstEntity(RS2::ResolveAll); e;
-                e=ec->nextEntity(RS2::ResolveAll)) {
-            //for (int i=0; i<container->count(); ++i) {
-            //    RS_Entity* e = container->entityAt(i);
+        for (RS_Entity* e: ec->deepEntities(RS2::ResolveAll)) {
 
             if (e) {
 
@@ -2450,6 +2470,371 @@ bool RS_Modification::cut(const RS_Vector& cutCoord,
 
 
 
+namespace {
+/**
+ * Position of a split point along an atomic entity
+ */
+struct SplitPoint {
+	double t;
+	RS_Vector point;
+};
+
+/**
+ * Result of splitting one entity, computed on a worker thread. Entities
+ * are only created on the calling thread.
+ */
+struct PlanarizeResult {
+	std::vector<RS_LineData> lines;
+	std::vector<RS_ArcData> arcs;
+	std::vector<std::vector<std::pair<RS_Vector, double>>> polylines;
+};
+
+using PlanarizePoints = std::unordered_map<RS_Entity const*, std::vector<RS_Vector>>;
+
+const double planarizeTolerance = 1.0e-6;
+
+/**
+ * @brief sortSplitPoints sort the split points of a line, arc or circle
+ * along the entity and drop duplicates
+ * @param atStart set, if a point is at the startpoint of the entity
+ * @param atEnd set, if a point is at the endpoint of the entity
+ * @return interior split points, t is the distance (line) or the angle
+ * from the start (arc, circle)
+ */
+std::vector<SplitPoint> sortSplitPoints(RS_Entity const* e,
+										const PlanarizePoints& points,
+										bool* atStart, bool* atEnd)
+{
+	std::vector<SplitPoint> ret;
+	*atStart = *atEnd = false;
+	auto it = points.find(e);
+	if (it == points.end())
+		return ret;
+
+	double scale = 1.;
+	for (const RS_Vector& vp: it->second) {
+		switch (e->rtti()) {
+		case RS2::EntityLine: {
+			auto line = static_cast<RS_Line const*>(e);
+			if (vp.distanceTo(line->getStartpoint()) < planarizeTolerance)
+				*atStart = true;
+			else if (vp.distanceTo(line->getEndpoint()) < planarizeTolerance)
+				*atEnd = true;
+			else
+				ret.push_back({vp.distanceTo(line->getStartpoint()), vp});
+			break;
+		}
+		case RS2::EntityArc: {
+			auto arc = static_cast<RS_Arc const*>(e);
+			scale = arc->getRadius();
+			if (vp.distanceTo(arc->getStartpoint()) < planarizeTolerance)
+				*atStart = true;
+			else if (vp.distanceTo(arc->getEndpoint()) < planarizeTolerance)
+				*atEnd = true;
+			else
+				ret.push_back({RS_Math::getAngleDifference(arc->getAngle1(),
+														   arc->getCenter().angleTo(vp),
+														   arc->isReversed()), vp});
+			break;
+		}
+		case RS2::EntityCircle: {
+			auto circle = static_cast<RS_Circle const*>(e);
+			scale = circle->getRadius();
+			ret.push_back({RS_Math::correctAngle(circle->getCenter().angleTo(vp)), vp});
+			break;
+		}
+		default:
+			return {};
+		}
+	}
+
+	std::sort(ret.begin(), ret.end(), [](const SplitPoint& lhs, const SplitPoint& rhs) {
+		return lhs.t < rhs.t;
+	});
+	ret.erase(std::unique(ret.begin(), ret.end(), [scale](const SplitPoint& lhs, const SplitPoint& rhs) {
+		return (rhs.t - lhs.t) * scale < planarizeTolerance;
+	}), ret.end());
+	// a circle is closed, the last point may duplicate the first one
+	if (e->rtti() == RS2::EntityCircle && ret.size() >= 2
+			&& (2. * M_PI - ret.back().t + ret.front().t) * scale < planarizeTolerance)
+		ret.pop_back();
+	return ret;
+}
+
+/**
+ * Splits a line, arc or circle at its intersections.
+ * @return true, if the entity is split into pieces
+ */
+bool planarizeAtomic(RS_Entity const* e, const PlanarizePoints& points,
+					 PlanarizeResult& result)
+{
+	bool atStart, atEnd;
+	std::vector<SplitPoint> const splits = sortSplitPoints(e, points, &atStart, &atEnd);
+	if (splits.empty())
+		return false;
+
+	switch (e->rtti()) {
+	case RS2::EntityLine: {
+		RS_Vector start = static_cast<RS_Line const*>(e)->getStartpoint();
+		for (const SplitPoint& sp: splits) {
+			result.lines.emplace_back(start, sp.point);
+			start = sp.point;
+		}
+		result.lines.emplace_back(start, static_cast<RS_Line const*>(e)->getEndpoint());
+		return true;
+	}
+	case RS2::EntityArc: {
+		auto arc = static_cast<RS_Arc const*>(e);
+		double a1 = arc->getAngle1();
+		for (const SplitPoint& sp: splits) {
+			double const a2 = arc->getCenter().angleTo(sp.point);
+			result.arcs.emplace_back(arc->getCenter(), arc->getRadius(), a1, a2, arc->isReversed());
+			a1 = a2;
+		}
+		result.arcs.emplace_back(arc->getCenter(), arc->getRadius(), a1, arc->getAngle2(),
+								 arc->isReversed());
+		return true;
+	}
+	case RS2::EntityCircle: {
+		auto circle = static_cast<RS_Circle const*>(e);
+		// whole 2 pi range arc for a single point, like cut()
+		for (size_t i = 0; i < splits.size(); ++i) {
+			double const a1 = splits[i].t;
+			double const a2 = (i + 1 < splits.size()) ? splits[i + 1].t : splits.front().t + 2. * M_PI;
+			result.arcs.emplace_back(circle->getCenter(), circle->getRadius(), a1, a2, false);
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+/**
+ * Splits a polyline at its intersections and at vertices touched by
+ * other entities. The pieces are open polylines given as vertices and
+ * bulges.
+ * @return true, if the polyline is split into pieces
+ */
+bool planarizePolyline(RS_Polyline const& polyline, const PlanarizePoints& points,
+					   PlanarizeResult& result)
+{
+	std::vector<RS_AtomicEntity const*> segments;
+	for (RS_Entity const* e: polyline) {
+		if (!e || !(e->rtti() == RS2::EntityLine || e->rtti() == RS2::EntityArc))
+			return false;
+		segments.push_back(static_cast<RS_AtomicEntity const*>(e));
+	}
+	size_t const n = segments.size();
+	if (n == 0)
+		return false;
+
+	// split points per segment, cuts at vertex i (start of segment i)
+	std::vector<std::vector<SplitPoint>> splits(n);
+	std::vector<char> cutAt(n + 1, 0);
+	bool interior = false;
+	for (size_t i = 0; i < n; ++i) {
+		bool atStart, atEnd;
+		splits[i] = sortSplitPoints(segments[i], points, &atStart, &atEnd);
+		interior = interior || !splits[i].empty();
+		cutAt[i] = cutAt[i] || atStart;
+		cutAt[i + 1] = cutAt[i + 1] || atEnd;
+	}
+	bool const closed = polyline.isClosed();
+	bool const cutAtStart = closed && (cutAt[0] || cutAt[n]);
+	if (!(interior || cutAtStart
+		  || std::find(cutAt.begin() + 1, cutAt.end() - 1, 1) != cutAt.end() - 1))
+		return false;
+
+	std::vector<std::vector<std::pair<RS_Vector, double>>> chains;
+	std::vector<std::pair<RS_Vector, double>> chain;
+	for (size_t i = 0; i < n; ++i) {
+		RS_AtomicEntity const* segment = segments[i];
+		if (i > 0 && cutAt[i]) {
+			chain.emplace_back(segment->getStartpoint(), 0.);
+			chains.push_back(std::move(chain));
+			chain.clear();
+		}
+
+		RS_Arc const* arc = (segment->rtti() == RS2::EntityArc)
+				? static_cast<RS_Arc const*>(segment) : nullptr;
+		double const sign = (arc && arc->isReversed()) ? -1. : 1.;
+		double const length = arc ? arc->getAngleLength() : 0.;
+		RS_Vector start = segment->getStartpoint();
+		double t = 0.;
+		for (const SplitPoint& sp: splits[i]) {
+			chain.emplace_back(start, arc ? sign * std::tan((sp.t - t) / 4.) : 0.);
+			chain.emplace_back(sp.point, 0.);
+			chains.push_back(std::move(chain));
+			chain.clear();
+			start = sp.point;
+			t = sp.t;
+		}
+		chain.emplace_back(start, arc ? sign * std::tan((length - t) / 4.) : 0.);
+	}
+	chain.emplace_back(segments.back()->getEndpoint(), 0.);
+	chains.push_back(std::move(chain));
+
+	// the first and the last piece of a closed polyline are connected
+	if (closed && !cutAtStart && chains.size() > 1) {
+		std::vector<std::pair<RS_Vector, double>>& last = chains.back();
+		last.pop_back();
+		last.insert(last.end(), chains.front().begin(), chains.front().end());
+		chains.front() = std::move(last);
+		chains.pop_back();
+	}
+
+	result.polylines = std::move(chains);
+	return true;
+}
+}
+
+/**
+ * Breaks all selected lines, arcs, circles and polylines at their mutual
+ * intersections (planarize). Other selected entities are used to split
+ * but are not split themselves. Intersections are found with
+ * RS_Information::getIntersections(), the pieces are computed on worker
+ * threads. All changes are added to one undo cycle.
+ *
+ * @return true if at least one entity was split.
+ */
+bool RS_Modification::planarize()
+{
+	if (!container) {
+		RS_DEBUG->print(RS_Debug::D_WARNING,
+						"RS_Modification::planarize: no valid container");
+		return false;
+	}
+
+	std::vector<RS_Entity*> entities;
+	for (auto e: container->selectedEntities()) {
+		if (e && e->isSelected() && e->isVisible())
+			entities.push_back(e);
+	}
+	if (entities.empty())
+		return false;
+
+	PlanarizePoints points;
+	for (const RS_IntersectionData& data: RS_Information::getIntersections(entities)) {
+		points[data.entity1].push_back(data.point);
+		points[data.entity2].push_back(data.point);
+	}
+	if (points.empty())
+		return false;
+
+	std::vector<PlanarizeResult> results(entities.size());
+	std::vector<char> split(entities.size(), 0);
+	LC_Parallel::forRange(entities.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			RS_Entity const* e = entities[i];
+			if (e->isLocked())
+				continue;
+			if (e->rtti() == RS2::EntityPolyline)
+				split[i] = planarizePolyline(*static_cast<RS_Polyline const*>(e), points, results[i]);
+			else
+				split[i] = planarizeAtomic(e, points, results[i]);
+		}
+	}, 16);
+
+	LC_UndoSection undo( document, handleUndo);
+	bool ret = false;
+	for (size_t i = 0; i < entities.size(); ++i) {
+		if (!split[i])
+			continue;
+		RS_Entity* e = entities[i];
+		auto addPiece = [&](RS_Entity* piece) {
+			piece->setPen(e->getPen(false));
+			piece->setLayer(e->getLayer(false));
+			container->addEntity(piece);
+			undo.addUndoable(piece);
+		};
+		for (const RS_LineData& d: results[i].lines)
+			addPiece(new RS_Line(container, d));
+		for (const RS_ArcData& d: results[i].arcs)
+			addPiece(new RS_Arc(container, d));
+		for (const auto& vertices: results[i].polylines) {
+			auto pl = new RS_Polyline(container, RS_PolylineData());
+			pl->appendVertexs(vertices);
+			addPiece(pl);
+		}
+
+		e->setSelected(false);
+		e->changeUndoState();
+		undo.addUndoable(e);
+		ret = true;
+	}
+
+	RS_DEBUG->print("RS_Modification::planarize: %d entities intersected",
+					static_cast<int>(points.size()));
+
+	if (ret) {
+		container->calculateBorders();
+		if (graphicView) {
+			graphicView->redraw(RS2::RedrawDrawing);
+		}
+	}
+	return ret;
+}
+
+
+
+/**
+ * Combines the region of data.subject with the regions of the selected
+ * closed contours, in the order of selectedEntities(). The result is added as
+ * closed polylines, the operands are kept and deselected.
+ */
+bool RS_Modification::combineRegions(const RS_RegionData& data)
+{
+	if (!container || !data.subject) {
+		RS_DEBUG->print(RS_Debug::D_WARNING,
+						"RS_Modification::combineRegions: no valid container or subject");
+		return false;
+	}
+
+	LC_RegionOps::Loops result = LC_RegionOps::loops(data.subject, data.tolerance);
+	if (result.empty())
+		return false;
+	std::vector<RS_Entity*> operands{data.subject};
+	for (auto e: container->selectedEntities()) {
+		if (e == data.subject)
+			continue;
+		LC_RegionOps::Loops const clip = LC_RegionOps::loops(e, data.tolerance);
+		if (clip.empty())
+			continue;
+		result = LC_RegionOps::combine(result, clip, data.operation);
+		operands.push_back(e);
+	}
+	if (operands.size() < 2)
+		return false;
+
+	LC_UndoSection undo( document, handleUndo);
+	for (const LC_RegionOps::Loop& loop: result) {
+		std::vector<std::pair<RS_Vector, double>> vertices;
+		for (const RS_Vector& v: loop)
+			vertices.emplace_back(v, 0.);
+		auto pl = new RS_Polyline(container, RS_PolylineData());
+		pl->setClosed(true);
+		pl->appendVertexs(vertices);
+		pl->setPen(data.subject->getPen(false));
+		pl->setLayer(data.subject->getLayer(false));
+		container->addEntity(pl);
+		undo.addUndoable(pl);
+	}
+	for (auto e: operands)
+		e->setSelected(false);
+
+	RS_DEBUG->print("RS_Modification::combineRegions: %d loops, area %f",
+					static_cast<int>(result.size()), LC_RegionOps::area(result));
+
+	container->calculateBorders();
+	if (graphicView) {
+		graphicView->redraw(RS2::RedrawDrawing);
+	}
+	return true;
+}
+
+
+
 /**
  * Stretching.
  */
@@ -3045,7 +3430,7 @@ bool RS_Modification::explode(const bool remove /*= true*/)
 
 	std::vector<RS_Entity*> addList;
 
-    for(auto e: *container){
+    for(auto e: container->selectedEntities()){
         //for (unsigned i=0; i<container->count(); ++i) {
         //RS_Entity* e = container->entityAt(i);
 
@@ -3159,7 +3544,7 @@ bool RS_Modification::explodeTextIntoLetters() {
 
 	std::vector<RS_Entity*> addList;
 
-	for(auto e: *container){
+	for(auto e: container->selectedEntities()){
         if (e && e->isSelected()) {
             if (e->rtti()==RS2::EntityMText) {
                 // add letters of text:
@@ -3304,7 +3689,7 @@ bool RS_Modification::moveRef(RS_MoveRefData& data) {
 	std::vector<RS_Entity*> addList;
 
     // Create new entities
-	for(auto e: *container){
+	for(auto e: container->selectedEntities()){
 		if (e && e->isSelected()) {
             RS_Entity* ec = e->clone();
 
@@ -40,6 +40,7 @@ class RS_Polyline;
 class RS_Document;
 class RS_Graphic;
 class RS_GraphicView;
+class RS_RegionData;
 
 /**
  * Holds the data needed for move modifications.
@@ -258,6 +259,8 @@ public:
                     double dist);
     bool offset(const RS_OffsetData& data);
     bool cut(const RS_Vector& cutCoord, RS_AtomicEntity* cutEntity);
+    bool planarize();
+	bool combineRegions(const RS_RegionData& data);
     bool stretch(const RS_Vector& firstCorner,
                                 const RS_Vector& secondCorner,
                                 const RS_Vector& offset);
@@ -24,6 +24,7 @@
 **
 **********************************************************************/
 
+#include <vector>
 #include "rs_selection.h"
 
 #include "rs_line.h"
@@ -75,19 +76,14 @@ void RS_Selection::selectSingle(RS_Entity* e) {
  * Selects all entities on visible layers.
  */
 void RS_Selection::selectAll(bool select) {
-    if (graphicView) {
-        //graphicView->deleteEntity(container);
-    }
-
-	//container->setSelected(select);
+	std::vector<RS_Entity*> entities;
+	entities.reserve(container->count());
 	for(auto e: *container){
-    //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
-
         if (e && e->isVisible()) {
-            e->setSelected(select);
+			entities.push_back(e);
         }
     }
+	container->selectEntities(entities, select);
 
 	if (graphicView) {
         //graphicView->drawEntity(container);
@@ -101,18 +97,15 @@ void RS_Selection::selectAll(bool select) {
  * Selects all entities on visible layers.
  */
 void RS_Selection::invertSelection() {
-    if (graphicView) {
-        //graphicView->deleteEntity(container);
-    }
-
+	std::vector<RS_Entity*> selected;
+	std::vector<RS_Entity*> deselected;
 	for(auto e: *container){
-    //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
-
         if (e && e->isVisible()) {
-            e->toggleSelected();
+			(e->isSelected() ? selected : deselected).push_back(e);
         }
     }
+	container->selectEntities(selected, false);
+	container->selectEntities(deselected, true);
 
     if (graphicView) {
         //graphicView->drawEntity(container);
@@ -153,6 +146,7 @@ void RS_Selection::selectIntersected(const RS_Vector& v1, const RS_Vector& v2,
 
 	RS_Line line{v1, v2};
     bool inters;
+	std::vector<RS_Entity*> entities;
 
 	for(auto e: *container){
     //for (unsigned i=0; i<container->count(); ++i) {
@@ -187,19 +181,14 @@ void RS_Selection::selectIntersected(const RS_Vector& v1, const RS_Vector& v2,
             }
 
             if (inters) {
-                if (graphicView) {
-                    graphicView->deleteEntity(e);
-                }
-
-                e->setSelected(select);
-
-                if (graphicView) {
-                    graphicView->drawEntity(e);
-                }
+				entities.push_back(e);
             }
         }
     }
 
+	if (container->selectEntities(entities, select) && graphicView) {
+		graphicView->redraw();
+	}
 }
 
 
@@ -316,6 +305,7 @@ void RS_Selection::selectLayer(RS_Entity* e) {
  */
 void RS_Selection::selectLayer(const QString& layerName, bool select) {
 
+	std::vector<RS_Entity*> entities;
 	for(auto en: *container){
 
         if (en && en->isVisible() && 
@@ -325,16 +315,14 @@ void RS_Selection::selectLayer(const QString& layerName, bool select) {
             RS_Layer* l = en->getLayer(true);
 
             if (l && l->getName()==layerName) {
-                if (graphicView) {
-                    graphicView->deleteEntity(en);
-                }
-                en->setSelected(select);
-                if (graphicView) {
-                    graphicView->drawEntity(en);
-                }
+				entities.push_back(en);
             }
         }
     }
+
+	if (container->selectEntities(entities, select) && graphicView) {
+		graphicView->redraw();
+	}
 }
 
 // EOF
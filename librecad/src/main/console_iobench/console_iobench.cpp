@@ -0,0 +1,652 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2026 librecad.org (www.librecad.org)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QtCore>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+#include "lc_entitysink.h"
+#include "lc_filtersnapshot.h"
+#include "rs_block.h"
+#include "rs_blocklist.h"
+#include "rs_debug.h"
+#include "rs_fileio.h"
+#include "rs_filterdxfrw.h"
+#include "rs_fontlist.h"
+#include "rs_graphic.h"
+#include "rs_hatch.h"
+#include "rs_insert.h"
+#include "rs_mtext.h"
+#include "rs_patternlist.h"
+#include "rs_polyline.h"
+#include "rs_settings.h"
+#include "rs_system.h"
+#include "rs_text.h"
+
+#include "main.h"
+
+#include "console_iobench.h"
+
+namespace {
+
+struct SaveFormat {
+	QString name;
+	RS2::FormatType type;
+	QString extension;
+};
+
+const std::vector<SaveFormat> saveFormats{
+	{"dxf", RS2::FormatDXFRW, "dxf"},
+	{"dxf-binary", RS2::FormatDXFRWBinary, "dxf"},
+	{"dxf-r12", RS2::FormatDXFRW12, "dxf"},
+	{"lcsnap", RS2::FormatSnapshot, "lcsnap"},
+	{"jww", RS2::FormatJWW, "jww"}
+};
+
+const QStringList corpusFilters{"*.dxf", "*.dwg", "*.jww", "*.cxf", "*.lff", "*.lcsnap"};
+
+double elapsedMs(const QElapsedTimer& timer)
+{
+	return timer.nsecsElapsed()*1e-6;
+}
+
+/** @return peak resident set size of this process in KiB, -1 if unknown */
+qint64 peakRssKiB()
+{
+#if defined(Q_OS_WIN)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return static_cast<qint64>(counters.PeakWorkingSetSize/1024);
+#elif defined(Q_OS_UNIX)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(Q_OS_MAC)
+		// bytes on macOS, KiB elsewhere
+		return usage.ru_maxrss/1024;
+#else
+		return usage.ru_maxrss;
+#endif
+	}
+#endif
+	return -1;
+}
+
+RS2::FormatType formatOf(const QString& file)
+{
+	// RS_FileIO::detectFormat() doesn't know JWW
+	if (QFileInfo(file).suffix().compare("jww", Qt::CaseInsensitive) == 0)
+		return RS2::FormatJWW;
+	return RS_FileIO::detectFormat(file);
+}
+
+QString formatName(RS2::FormatType type, const QString& file)
+{
+	for (const SaveFormat& format: saveFormats) {
+		if (format.type == type)
+			return format.name;
+	}
+	return QFileInfo(file).suffix().toLower();
+}
+
+/**
+ * @brief generatedEntities entities of c with generated geometry, which
+ * RS_Graphic::updateEntities() regenerates after loading. Inserts are
+ * updated by updateEntities() anyway.
+ */
+void generatedEntities(RS_EntityContainer& c, std::vector<RS_Entity*>& entities)
+{
+	for (RS_Entity* e: c) {
+		switch (e->rtti()) {
+		case RS2::EntityHatch:
+		case RS2::EntityText:
+		case RS2::EntityMText:
+		case RS2::EntityDimAligned:
+		case RS2::EntityDimLinear:
+		case RS2::EntityDimRadial:
+		case RS2::EntityDimDiametric:
+		case RS2::EntityDimAngular:
+		case RS2::EntityDimLeader:
+			entities.push_back(e);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/**
+ * Differences between a drawing and its reloaded copy. Only the first
+ * few are described.
+ */
+struct Mismatches {
+	int count = 0;
+	QStringList examples;
+
+	void add(const QString& where, const QString& what) {
+		if (examples.size() < 10)
+			examples << where + ": " + what;
+		++count;
+	}
+};
+
+/** @return true if a and b agree within the precision of the file formats */
+bool sameValue(double a, double b)
+{
+	return std::abs(a - b) <= 1e-6*std::max({1., std::abs(a), std::abs(b)});
+}
+
+bool samePoint(const RS_Vector& a, const RS_Vector& b)
+{
+	return a.valid == b.valid
+			&& (!a.valid || (sameValue(a.x, b.x) && sameValue(a.y, b.y)));
+}
+
+/** angles are compared as directions, 0 and 2 pi are the same */
+bool sameAngle(double a, double b)
+{
+	return samePoint(RS_Vector(a), RS_Vector(b));
+}
+
+void compareEntities(RS_EntityContainer& original, RS_EntityContainer& reloaded,
+					 const QString& where, Mismatches& mismatches, int count = -1);
+
+/**
+ * Compares an entity with its reloaded copy: the type, the reference
+ * points (end points, centers, vertices, control and definition points),
+ * the extents of leaves and the data of inserts, texts, polylines and
+ * hatches. Generated content, like the entities of inserts, texts and
+ * dimensions, isn't compared, blocks are compared on their own.
+ */
+void compareEntity(RS_Entity* a, RS_Entity* b, const QString& where, Mismatches& mismatches)
+{
+	if (a->rtti() != b->rtti()) {
+		mismatches.add(where, QString("entity type %1 became %2").arg(a->rtti()).arg(b->rtti()));
+		return;
+	}
+
+	RS_VectorSolutions const refA = a->getRefPoints();
+	RS_VectorSolutions const refB = b->getRefPoints();
+	bool sameRefs = refA.size() == refB.size();
+	for (size_t i = 0; sameRefs && i < refA.size(); ++i)
+		sameRefs = samePoint(refA.at(i), refB.at(i));
+	if (!sameRefs)
+		mismatches.add(where, "reference points differ");
+	if (!a->isContainer()
+			&& !(samePoint(a->getMin(), b->getMin()) && samePoint(a->getMax(), b->getMax())))
+		mismatches.add(where, "extents differ");
+
+	switch (a->rtti()) {
+	case RS2::EntityInsert: {
+		RS_Insert* ia = static_cast<RS_Insert*>(a);
+		RS_Insert* ib = static_cast<RS_Insert*>(b);
+		if (ia->getName() != ib->getName())
+			mismatches.add(where, "insert of " + ia->getName() + " became " + ib->getName());
+		if (!samePoint(ia->getInsertionPoint(), ib->getInsertionPoint())
+				|| !samePoint(ia->getScale(), ib->getScale())
+				|| !sameAngle(ia->getAngle(), ib->getAngle())
+				|| ia->getCols() != ib->getCols() || ia->getRows() != ib->getRows())
+			mismatches.add(where, "insert position, scale or angle differs");
+		break;
+	}
+	case RS2::EntityText: {
+		RS_Text* ta = static_cast<RS_Text*>(a);
+		RS_Text* tb = static_cast<RS_Text*>(b);
+		if (ta->getText() != tb->getText())
+			mismatches.add(where, "text differs");
+		if (!samePoint(ta->getInsertionPoint(), tb->getInsertionPoint())
+				|| !sameValue(ta->getHeight(), tb->getHeight())
+				|| !sameAngle(ta->getAngle(), tb->getAngle()))
+			mismatches.add(where, "text position, height or angle differs");
+		break;
+	}
+	case RS2::EntityMText: {
+		RS_MText* ta = static_cast<RS_MText*>(a);
+		RS_MText* tb = static_cast<RS_MText*>(b);
+		if (ta->getText() != tb->getText())
+			mismatches.add(where, "text differs");
+		if (!samePoint(ta->getInsertionPoint(), tb->getInsertionPoint())
+				|| !sameValue(ta->getHeight(), tb->getHeight())
+				|| !sameAngle(ta->getAngle(), tb->getAngle()))
+			mismatches.add(where, "text position, height or angle differs");
+		break;
+	}
+	case RS2::EntityPolyline:
+		if (static_cast<RS_Polyline*>(a)->isClosed() != static_cast<RS_Polyline*>(b)->isClosed())
+			mismatches.add(where, "closed flag differs");
+		// the segments carry the bulges
+		compareEntities(*static_cast<RS_EntityContainer*>(a),
+						*static_cast<RS_EntityContainer*>(b), where, mismatches);
+		break;
+	case RS2::EntityHatch: {
+		RS_Hatch* ha = static_cast<RS_Hatch*>(a);
+		RS_Hatch* hb = static_cast<RS_Hatch*>(b);
+		if (ha->isSolid() != hb->isSolid()
+				|| (!ha->isSolid()
+					&& (ha->getPattern().compare(hb->getPattern(), Qt::CaseInsensitive) != 0
+						|| !sameValue(ha->getScale(), hb->getScale())
+						|| !sameAngle(ha->getAngle(), hb->getAngle()))))
+			mismatches.add(where, "hatch pattern, scale or angle differs");
+		if (ha->countLoops() != hb->countLoops()) {
+			mismatches.add(where, QString("%1 hatch loops, %2 after reload")
+						   .arg(ha->countLoops()).arg(hb->countLoops()));
+			break;
+		}
+		// the loops come first, followed by the generated pattern
+		compareEntities(*ha, *hb, where, mismatches, ha->countLoops());
+		break;
+	}
+	case RS2::EntityContainer:
+		compareEntities(*static_cast<RS_EntityContainer*>(a),
+						*static_cast<RS_EntityContainer*>(b), where, mismatches);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Compares the entities of two containers pairwise, in order.
+ * @param count number of entities to compare, all if negative
+ */
+void compareEntities(RS_EntityContainer& original, RS_EntityContainer& reloaded,
+					 const QString& where, Mismatches& mismatches, int count)
+{
+	if (count < 0) {
+		if (original.count() != reloaded.count())
+			mismatches.add(where, QString("%1 entities, %2 after reload")
+						   .arg(original.count()).arg(reloaded.count()));
+		count = static_cast<int>(std::min(original.count(), reloaded.count()));
+	}
+	for (int i = 0; i < count; ++i)
+		compareEntity(original.entityAt(i), reloaded.entityAt(i),
+					  where + "/" + QString::number(i), mismatches);
+}
+
+/** compares the model space and the blocks of a drawing with its reloaded copy */
+Mismatches compareGraphics(RS_Graphic& original, RS_Graphic& reloaded)
+{
+	Mismatches mismatches;
+	compareEntities(original, reloaded, "model space", mismatches);
+	for (RS_Block* block: *original.getBlockList()) {
+		QString const where = "block " + block->getName();
+		RS_Block* copy = reloaded.getBlockList()->find(block->getName());
+		if (copy)
+			compareEntities(*block, *copy, where, mismatches);
+		else
+			mismatches.add(where, "missing after reload");
+	}
+	return mismatches;
+}
+
+/**
+ * Saves g the way RS_Graphic::autoSaveTask() does: a snapshot of g is read
+ * into a copy, which is regenerated and exported on a worker thread.
+ */
+bool autoSave(RS_Graphic& g, const QString& file, RS2::FormatType type)
+{
+	QByteArray const data = LC_FilterSnapshot::serialize(g);
+	RS_Graphic copy;
+	g.loadResources();
+	RS_FileIO* io = RS_FileIO::instance();
+	return std::async(std::launch::async, [&]() {
+		return LC_FilterSnapshot::deserialize(copy, data, true)
+				&& io->fileExport(copy, file, type);
+	}).get();
+}
+
+/** bounded memory consumer of a streaming import: counts and extents */
+class ExtentSink : public LC_EntitySink {
+public:
+	void addEntity(RS_Entity* entity) override {
+		++count;
+		minV = minV.valid ? RS_Vector::minimum(minV, entity->getMin()) : entity->getMin();
+		maxV = maxV.valid ? RS_Vector::maximum(maxV, entity->getMax()) : entity->getMax();
+	}
+
+	unsigned count = 0;
+	RS_Vector minV{false};
+	RS_Vector maxV{false};
+};
+
+/** @return true if RS_FilterDXFRW can stream files of type to a sink */
+bool isStreamable(RS2::FormatType type)
+{
+#ifdef DWGSUPPORT
+	if (type == RS2::FormatDWG)
+		return true;
+#endif
+	return type == RS2::FormatDXFRW;
+}
+
+void keepMinimum(double& best, double value)
+{
+	if (best < 0. || value < best)
+		best = value;
+}
+
+/**
+ * Benchmarks one file:
+ * - probe: RS_FileIO::fileProbe(), for DXF this tokenizes all entities
+ *   without creating them
+ * - import: RS_FileIO::fileImport(), parsing, entity creation and the
+ *   regeneration of texts, hatches, dimensions and inserts
+ * - regen: the regeneration alone, repeated on the loaded drawing
+ * - stream: DXF and DWG import into an ExtentSink, which keeps no model
+ *   space entities
+ * - create: importMs - probeMs - regenMs, only if probe parsed the entities
+ * - save and reload in each save format, with a round trip check of the
+ *   numbers of entities, layers and blocks and of the geometry of all
+ *   entities, see compareEntity()
+ * - an auto save in each save format, reloaded and compared with the
+ *   reloaded save
+ * Timings are the minimum of all repetitions.
+ */
+QJsonObject benchmarkFile(const QString& file, int repeat,
+						  const std::vector<SaveFormat>& formats, const QDir& tempDir)
+{
+	RS_FileIO* io = RS_FileIO::instance();
+	RS2::FormatType const type = formatOf(file);
+	QJsonObject result;
+	result["file"] = file;
+	result["format"] = formatName(type, file);
+	result["bytes"] = static_cast<double>(QFileInfo(file).size());
+
+	double probeMs = -1.;
+	double importMs = -1.;
+	double regenMs = -1.;
+	double streamMs = -1.;
+	int streamed = -1;
+	bool parsedEntities = false;
+	std::unique_ptr<RS_Graphic> graphic;
+	QElapsedTimer timer;
+	for (int i = 0; i < repeat; ++i) {
+		{
+			RS_Graphic probed;
+			std::map<QString, int> counts;
+			timer.start();
+			if (io->fileProbe(probed, file, &counts, type)) {
+				keepMinimum(probeMs, elapsedMs(timer));
+				parsedEntities = !counts.empty();
+			}
+		}
+
+		if (isStreamable(type)) {
+			RS_Graphic target;
+			ExtentSink sink;
+			RS_FilterDXFRW filter;
+			filter.setEntitySink(&sink);
+			timer.start();
+			if (filter.fileImport(target, file, type)) {
+				keepMinimum(streamMs, elapsedMs(timer));
+				streamed = static_cast<int>(sink.count);
+			}
+		}
+
+		// the previous drawing is freed first, it would distort peak memory
+		graphic.reset();
+		graphic.reset(new RS_Graphic());
+		timer.start();
+		if (!io->fileImport(*graphic, file, type)) {
+			result["error"] = QString("import failed");
+			return result;
+		}
+		keepMinimum(importMs, elapsedMs(timer));
+
+		std::vector<RS_Entity*> generated;
+		generatedEntities(*graphic, generated);
+		for (RS_Block* block: *graphic->getBlockList())
+			generatedEntities(*block, generated);
+		timer.start();
+		graphic->updateEntities(generated);
+		keepMinimum(regenMs, elapsedMs(timer));
+	}
+
+	unsigned const entities = graphic->count();
+	unsigned const layers = graphic->countLayers();
+	int const blocks = graphic->getBlockList()->count();
+	result["entities"] = static_cast<int>(entities);
+	result["layers"] = static_cast<int>(layers);
+	result["blocks"] = blocks;
+	result["probe_ms"] = probeMs < 0. ? QJsonValue() : QJsonValue(probeMs);
+	result["import_ms"] = importMs;
+	result["regen_ms"] = regenMs;
+	if (parsedEntities)
+		result["create_ms"] = std::max(0., importMs - probeMs - regenMs);
+	if (streamMs >= 0.) {
+		result["stream_ms"] = streamMs;
+		result["stream_entities"] = streamed;
+	}
+
+	QJsonArray saves;
+	for (const SaveFormat& format: formats) {
+		QString const saved = tempDir.filePath("iobench." + format.extension);
+		QJsonObject save;
+		save["format"] = format.name;
+		double saveMs = -1.;
+		double reloadMs = -1.;
+		bool roundTrip = true;
+		for (int i = 0; i < repeat; ++i) {
+			timer.start();
+			if (!io->fileExport(*graphic, saved, format.type)) {
+				save["error"] = QString("save failed");
+				break;
+			}
+			keepMinimum(saveMs, elapsedMs(timer));
+			save["bytes"] = static_cast<double>(QFileInfo(saved).size());
+
+			RS_Graphic reloaded;
+			timer.start();
+			if (!io->fileImport(reloaded, saved, format.type)) {
+				save["error"] = QString("reload failed");
+				break;
+			}
+			keepMinimum(reloadMs, elapsedMs(timer));
+			if (i > 0)
+				continue;
+			// the reloaded drawing is the same on every repetition
+			Mismatches const mismatches = compareGraphics(*graphic, reloaded);
+			roundTrip = reloaded.count() == entities
+					&& reloaded.countLayers() == layers
+					&& reloaded.getBlockList()->count() == blocks
+					&& mismatches.count == 0;
+			save["mismatches"] = mismatches.count;
+			if (!mismatches.examples.isEmpty())
+				save["mismatch_examples"] = QJsonArray::fromStringList(mismatches.examples);
+
+			// the auto save is written from a copy, it must not lose anything
+			QString const autoSaved = tempDir.filePath("iobench-autosave." + format.extension);
+			RS_Graphic autoReloaded;
+			bool autoSaveMatches = autoSave(*graphic, autoSaved, format.type)
+					&& io->fileImport(autoReloaded, autoSaved, format.type);
+			if (autoSaveMatches) {
+				Mismatches const autoMismatches = compareGraphics(reloaded, autoReloaded);
+				autoSaveMatches = autoReloaded.count() == reloaded.count()
+						&& autoReloaded.getBlockList()->count() == reloaded.getBlockList()->count()
+						&& autoMismatches.count == 0;
+				save["auto_save_mismatches"] = autoMismatches.count;
+				if (!autoMismatches.examples.isEmpty())
+					save["auto_save_mismatch_examples"]
+							= QJsonArray::fromStringList(autoMismatches.examples);
+			}
+			save["auto_save_round_trip"] = autoSaveMatches;
+			QFile::remove(autoSaved);
+		}
+		QFile::remove(saved);
+		if (saveMs >= 0.)
+			save["save_ms"] = saveMs;
+		if (reloadMs >= 0.) {
+			save["reload_ms"] = reloadMs;
+			save["round_trip"] = roundTrip;
+		}
+		saves.append(save);
+	}
+	result["saves"] = saves;
+	return result;
+}
+
+} // namespace
+
+int console_iobench(int argc, char** argv)
+{
+	RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
+
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setOrganizationName("LibreCAD");
+	QCoreApplication::setApplicationName("LibreCAD");
+	QCoreApplication::setApplicationVersion(XSTR(LC_VERSION));
+
+	QFileInfo prgInfo(QFile::decodeName(argv[0]));
+	RS_SETTINGS->init(app.organizationName(), app.applicationName());
+	RS_SYSTEM->init(app.applicationName(), app.applicationVersion(),
+		XSTR(QC_APPDIR), prgInfo.absolutePath());
+
+	QCommandLineParser parser;
+	QString appDesc;
+	if (prgInfo.baseName() != "iobench")
+		appDesc = "\niobench usage: " + prgInfo.filePath() + " iobench [options] <files>\n";
+	appDesc += "\nLoad and save files through all file filters and write the timings,"
+			   "\nfile sizes and peak memory use as JSON. Directories are searched"
+			   "\nrecursively for " + corpusFilters.join(' ') + " files."
+			   "\n"
+			   "\nregen_ms is measured by regenerating texts, hatches, dimensions and"
+			   "\ninserts once more after the import, an estimate of the regeneration"
+			   "\nduring the import. create_ms is an estimate as well, import_ms minus"
+			   "\nprobe_ms and regen_ms. peak_rss_kib is the peak of the whole run.";
+	parser.setApplicationDescription(appDesc);
+	parser.addHelpOption();
+	parser.addVersionOption();
+
+	QCommandLineOption outFileOpt(QStringList() << "o" << "outfile",
+		"Output JSON file, default standard output.", "file");
+	parser.addOption(outFileOpt);
+
+	QCommandLineOption repeatOpt(QStringList() << "r" << "repeat",
+		"Repetitions per file, the fastest one is reported. Default 1.", "integer");
+	parser.addOption(repeatOpt);
+
+	QStringList formatNames;
+	for (const SaveFormat& format: saveFormats)
+		formatNames << format.name;
+	QCommandLineOption saveOpt(QStringList() << "s" << "save",
+		"Formats to save and reload each file in: " + formatNames.join(',')
+		+ " or none. Default dxf,dxf-binary,lcsnap.", "formats");
+	parser.addOption(saveOpt);
+
+	parser.addPositionalArgument("<files>", "Input files or directories");
+	parser.process(app);
+
+	QStringList args = parser.positionalArguments();
+	if (!args.isEmpty() && args.first() == "iobench")
+		args.removeFirst();
+	if (args.isEmpty())
+		parser.showHelp(EXIT_FAILURE);
+
+	int repeat = 1;
+	if (parser.isSet(repeatOpt))
+		repeat = std::max(1, parser.value(repeatOpt).toInt());
+
+	std::vector<SaveFormat> formats;
+	QString const saveValue = parser.isSet(saveOpt) ? parser.value(saveOpt) : "dxf,dxf-binary,lcsnap";
+	if (saveValue != "none") {
+		for (const QString& name: saveValue.split(',')) {
+			auto it = std::find_if(saveFormats.cbegin(), saveFormats.cend(),
+								   [&name](const SaveFormat& f) { return f.name == name.trimmed(); });
+			if (it == saveFormats.cend()) {
+				qWarning() << "ERROR: Unknown save format" << name;
+				return EXIT_FAILURE;
+			}
+			formats.push_back(*it);
+		}
+	}
+
+	QStringList files;
+	for (const QString& arg: args) {
+		if (QFileInfo(arg).isDir()) {
+			QStringList found;
+			QDirIterator it(arg, corpusFilters, QDir::Files, QDirIterator::Subdirectories);
+			while (it.hasNext())
+				found << it.next();
+			found.sort();
+			files << found;
+		} else {
+			files << arg;
+		}
+	}
+
+	QTemporaryDir tempDir;
+	if (!tempDir.isValid()) {
+		qWarning() << "ERROR: Cannot create a temporary directory";
+		return EXIT_FAILURE;
+	}
+
+	RS_FONTLIST->init();
+	RS_PATTERNLIST->init();
+
+	QTextStream progress(stderr);
+	QJsonArray results;
+	int failed = 0;
+	QElapsedTimer total;
+	total.start();
+	for (int i = 0; i < files.size(); ++i) {
+		progress << QString("[%1/%2] %3").arg(i + 1).arg(files.size()).arg(files[i]) << '\n';
+		progress.flush();
+		QJsonObject result = benchmarkFile(files[i], repeat, formats, QDir(tempDir.path()));
+		if (result.contains("error"))
+			++failed;
+		results.append(result);
+	}
+
+	QJsonObject report;
+	report["librecad"] = QString(XSTR(LC_VERSION));
+	report["qt"] = QString(qVersion());
+	report["threads"] = QThread::idealThreadCount();
+	report["repeat"] = repeat;
+	report["files"] = results;
+	report["failed"] = failed;
+	report["total_ms"] = elapsedMs(total);
+	report["peak_rss_kib"] = static_cast<double>(peakRssKiB());
+
+	QByteArray const json = QJsonDocument(report).toJson();
+	if (parser.isSet(outFileOpt)) {
+		QFile out(parser.value(outFileOpt));
+		if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate) || out.write(json) != json.size()) {
+			qWarning() << "ERROR: Cannot write" << out.fileName();
+			return EXIT_FAILURE;
+		}
+	} else {
+		QFile out;
+		out.open(stdout, QIODevice::WriteOnly);
+		out.write(json);
+	}
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -52,6 +52,8 @@
 #include "intern/qc_actiongetselect.h"
 #include "intern/qc_actiongetent.h"
 #include "rs_math.h"
+#include "rs_information.h"
+#include "lc_regionops.h"
 #include "rs_debug.h"
 // #include <QDebug>
 
@@ -1266,6 +1268,68 @@ bool Doc_plugin_interface::getAllEntities(QList<Plug_Entity *> *sel, bool visibl
     return status;
 }
 
+bool Doc_plugin_interface::getIntersections(QList<Plug_Entity *> *sel,
+                                            std::vector<Plug_IntersectionData> *result){
+    if (!(sel && result))
+        return false;
+
+    std::vector<RS_Entity*> entities;
+    entities.reserve(sel->size());
+    for (Plug_Entity* pe: *sel)
+        entities.push_back(pe ? reinterpret_cast<Plugin_Entity*>(pe)->getEnt() : nullptr);
+
+    for (const RS_IntersectionData& data: RS_Information::getIntersections(entities)) {
+        result->push_back({QPointF(data.point.x, data.point.y),
+                           static_cast<int>(data.source1),
+                           static_cast<int>(data.source2)});
+    }
+    return true;
+}
+
+bool Doc_plugin_interface::getRegion(QList<Plug_Entity *> *subject, QList<Plug_Entity *> *clip,
+                                     DPI::RegionOp op, double tolerance,
+                                     std::vector<std::vector<QPointF>> *result){
+    if (!(subject && clip && result) || tolerance <= 0.)
+        return false;
+
+    // even-odd within an operand, so the entities of an operand are united first
+    auto operand = [tolerance](QList<Plug_Entity *> *entities) {
+        LC_RegionOps::Loops region;
+        for (Plug_Entity* pe: *entities) {
+            if (!pe)
+                continue;
+            LC_RegionOps::Loops const loops =
+                    LC_RegionOps::loops(reinterpret_cast<Plugin_Entity*>(pe)->getEnt(), tolerance);
+            region = region.empty() ? loops : LC_RegionOps::combine(region, loops, LC_RegionOps::Union);
+        }
+        return region;
+    };
+
+    LC_RegionOps::Operation operation = LC_RegionOps::Union;
+    switch (op) {
+    case DPI::RegionIntersection:
+        operation = LC_RegionOps::Intersection;
+        break;
+    case DPI::RegionDifference:
+        operation = LC_RegionOps::Difference;
+        break;
+    case DPI::RegionXor:
+        operation = LC_RegionOps::Xor;
+        break;
+    default:
+        break;
+    }
+
+    for (const LC_RegionOps::Loop& loop: LC_RegionOps::combine(operand(subject), operand(clip), operation)) {
+        std::vector<QPointF> points;
+        points.reserve(loop.size());
+        for (const RS_Vector& v: loop)
+            points.emplace_back(v.x, v.y);
+        result->push_back(std::move(points));
+    }
+    return true;
+}
+
 bool Doc_plugin_interface::getVariableInt(const QString& key, int *num){
     if( (*num = docGr->getVariableInt(key, 0)) )
         return true;
@@ -113,6 +113,11 @@ public:
     Plug_Entity *getEnt(const QString& message) override;
     bool getSelect(QList<Plug_Entity *> *sel, const QString& message) override;
     bool getAllEntities(QList<Plug_Entity *> *sel, bool visible) override;
+    bool getIntersections(QList<Plug_Entity *> *sel,
+                          std::vector<Plug_IntersectionData> *result) override;
+    bool getRegion(QList<Plug_Entity *> *subject, QList<Plug_Entity *> *clip,
+                   DPI::RegionOp op, double tolerance,
+                   std::vector<std::vector<QPointF>> *result) override;
 
     bool getVariableInt(const QString& key, int *num) override;
     bool getVariableDouble(const QString& key, double *num) override;
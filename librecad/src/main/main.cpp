@@ -46,6 +46,7 @@
 #include "rs_debug.h"
 
 #include "console_dxf2pdf.h"
+#include "console_iobench.h"
 
 #if defined(qApp)
 #undef qApp
@@ -53,8 +54,8 @@
 #define qApp (dynamic_cast<QApplication *>(QCoreApplication::instance()))
 
 // Check first two arguments in order to decide if we want to run librecad
-// as console dxf2pdf tool. On Linux we can create a link to librecad
-// executable and  name it dxf2pdf. So, we can run either:
+// as console tool, dxf2pdf or iobench. On Linux we can create a link to
+// librecad executable and  name it dxf2pdf. So, we can run either:
 //
 //     librecad dxf2pdf [options] ...
 //
@@ -62,13 +63,13 @@
 //
 //     dxf2pdf [options] ...
 //
-bool runAsConsoleApp(int argc, char** argv) {
+bool runAsConsoleApp(int argc, char** argv, const QString& command) {
     for (int i = 0; i < qMin(argc, 2); i++) {
         QString arg(argv[i]);
         if (i == 0) {
             arg = QFileInfo(QFile::decodeName(argv[i])).baseName();
         }
-        if (arg.compare("dxf2pdf") == 0) {
+        if (arg.compare(command) == 0) {
             return true;
         }
     }
@@ -88,6 +89,7 @@ bool justNeedHelpAndExit(const QString &argument) {
         qDebug() << "Commands:";
         qDebug() << "";
         qDebug() << "  dxf2pdf\tRun librecad as console dxf2pdf tool. Use -h for help.";
+        qDebug() << "  iobench\tBenchmark loading and saving files. Use -h for help.";
         qDebug() << "";
         qDebug() << "Options:";
         qDebug() << "";
@@ -219,9 +221,12 @@ int main(int argc, char** argv)
 {
     QT_REQUIRE_VERSION(argc, argv, "5.2.1")
 
-    if(runAsConsoleApp(argc, argv)) {
+    if(runAsConsoleApp(argc, argv, "dxf2pdf")) {
         return console_dxf2pdf(argc, argv);
     }
+    if(runAsConsoleApp(argc, argv, "iobench")) {
+        return console_iobench(argc, argv);
+    }
 
     RS_DEBUG->setLevel(RS_Debug::D_WARNING);
 
@@ -697,6 +697,9 @@ void QC_ApplicationWindow::execPlug() {
 QC_ApplicationWindow::~QC_ApplicationWindow() {
     RS_DEBUG->print("QC_ApplicationWindow::~QC_ApplicationWindow");
 
+    if (autosaveResult.valid())
+        autosaveResult.wait();
+
     RS_DEBUG->print("QC_ApplicationWindow::~QC_ApplicationWindow: "
                     "deleting dialog factory");
 
@@ -930,8 +933,8 @@ void QC_ApplicationWindow::slotWindowActivated(QMdiSubWindow *w) {
 
         blockWidget->setBlockList(m->getDocument()->getBlockList());
 
-        // Update all inserts in this graphic (blocks might have changed):
-        m->getDocument()->updateInserts();
+        // Update the inserts of blocks that might have changed:
+        m->getDocument()->updateChangedInserts();
         // whether to enable undo/redo buttons
         m->getDocument()->setGUIButtons();
         m->getGraphicView()->redraw();
@@ -1808,26 +1811,47 @@ bool QC_ApplicationWindow::slotFileSaveAll() {
 void QC_ApplicationWindow::slotFileAutoSave() {
     RS_DEBUG->print("QC_ApplicationWindow::slotFileAutoSave()");
 
-    statusBar()->showMessage(tr("Auto-saving drawing..."), 2000);
+    // the previous auto-save is still being written
+    if (autosaveResult.valid())
+        return;
 
     QC_MDIWindow *w = getMDIWindow();
-    if (w) {
-        bool cancelled;
-        if (w->fileSave(cancelled, true)) {
-            // auto-save cannot be cancelled by user, so the
-            // "cancelled" parameter is a dummy
-            statusBar()->showMessage(tr("Auto-saved drawing"), 2000);
-        } else {
-            // error
-            autosaveTimer->stop();
-            QMessageBox::information(this, QMessageBox::tr("Warning"),
-                                     tr("Cannot auto-save the file\n%1\nPlease "
-                                        "check the permissions.\n"
-                                        "Auto-save disabled.")
-                                             .arg(w->getDocument()->getAutoSaveFilename()),
-                                     QMessageBox::Ok);
-            statusBar()->showMessage(tr("Auto-saving failed"), 2000);
+    if (w && w->getGraphic()) {
+        statusBar()->showMessage(tr("Auto-saving drawing..."), 2000);
+        // the drawing is copied here, the files are written in the
+        // background while editing goes on
+        autosaveFile = w->getDocument()->getAutoSaveFilename();
+        autosaveResult = w->getGraphic()->autoSaveInBackground();
+        if (!autosaveWatcher) {
+            autosaveWatcher = new QTimer(this);
+            autosaveWatcher->setInterval(100);
+            connect(autosaveWatcher, &QTimer::timeout,
+                    this, &QC_ApplicationWindow::slotFileAutoSaveDone);
         }
+        autosaveWatcher->start();
+    }
+}
+
+void QC_ApplicationWindow::slotFileAutoSaveDone() {
+    if (!autosaveResult.valid()
+        || autosaveResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    autosaveWatcher->stop();
+    bool const saved = autosaveResult.get();
+    autosaveResult = {};
+    if (saved) {
+        statusBar()->showMessage(tr("Auto-saved drawing"), 2000);
+    } else {
+        // error
+        autosaveTimer->stop();
+        QMessageBox::information(this, QMessageBox::tr("Warning"),
+                                 tr("Cannot auto-save the file\n%1\nPlease "
+                                    "check the permissions.\n"
+                                    "Auto-save disabled.")
+                                         .arg(autosaveFile),
+                                 QMessageBox::Ok);
+        statusBar()->showMessage(tr("Auto-saving failed"), 2000);
     }
 }
 
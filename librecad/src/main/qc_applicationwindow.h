@@ -33,6 +33,7 @@
 
 #include "rs_pen.h"
 #include "rs_snapper.h"
+#include <future>
 #include <QMap>
 #include <QSettings>
 
@@ -160,6 +161,8 @@ public slots:
 	bool slotFileSaveAll();
     /** auto-save document */
     void slotFileAutoSave();
+    /** reports the result of a background auto-save */
+    void slotFileAutoSaveDone();
     /** exports the document as bitmap */
     void slotFileExport();
     /** closing the current file */
@@ -308,6 +311,10 @@ private:
     /** Pointer to the application window (this). */
     static QC_ApplicationWindow* appWindow;
     QTimer *autosaveTimer {nullptr};
+    /** polls the auto-save running in the background */
+    QTimer *autosaveWatcher {nullptr};
+    std::shared_future<bool> autosaveResult;
+    QString autosaveFile;
 
     QG_ActionHandler* actionHandler {nullptr};
 
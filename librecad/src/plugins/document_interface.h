@@ -179,6 +179,14 @@ namespace DPI {
         das,
     };
 
+    //! Boolean operations on regions.
+    enum RegionOp {
+        RegionUnion,        /*!< area of any operand */
+        RegionIntersection, /*!< area common to all operands */
+        RegionDifference,   /*!< area of the subject not covered by the clip */
+        RegionXor           /*!< area covered by exactly one operand */
+    };
+
 }
 
 class Plug_VertexData
@@ -192,6 +200,17 @@ public:
     double bulge;
 };
 
+//! Intersection point found by Document_Interface::getIntersections().
+/*! entity1 and entity2 are the indices of the intersecting entities in
+ *  the list passed to getIntersections().
+ */
+struct Plug_IntersectionData
+{
+    QPointF point;
+    int entity1;
+    int entity2;
+};
+
 //! Wrapper for access entities from plugins.
  /*!
  *  Wrapper class for create, access and modify entities from plugins.
@@ -495,6 +514,33 @@ public:
     * \return a string with the converted number.
     */
     virtual QString realToStr(qreal num, int units, int prec) = 0;
+
+    //! Gets all intersections between entities.
+    /*! Computes the intersection points of all pairs of entities in sel,
+    * including the crossings between parts of different polylines or inserts.
+    * \param sel a QList of entities, i.e. from getSelect() or getAllEntities().
+    * \param result receives the intersection points, the entity indices refer to sel.
+    * \return true if success.
+    */
+    virtual bool getIntersections(QList<Plug_Entity *> *sel,
+                                  std::vector<Plug_IntersectionData> *result) = 0;
+
+    //! Boolean operation on the regions of closed contours.
+    /*! Closed polylines, circles, full ellipses and hatches bound regions,
+    * arcs are approximated by polygons within tolerance. Holes are loops
+    * inside of other loops. The document is not changed, use addLines()
+    * to add the result.
+    * \param subject entities bounding the first operand.
+    * \param clip entities bounding the second operand.
+    * \param op the operation.
+    * \param tolerance maximum distance of the result to arcs and ellipses.
+    * \param result receives the loops of the result, outer loops counter
+    * clockwise and holes clockwise.
+    * \return true if success.
+    */
+    virtual bool getRegion(QList<Plug_Entity *> *subject, QList<Plug_Entity *> *clip,
+                           DPI::RegionOp op, double tolerance,
+                           std::vector<std::vector<QPointF>> *result) = 0;
 };
 
 
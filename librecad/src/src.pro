@@ -72,6 +72,8 @@ win32 {
     }
 
     RC_FILE = ../res/main/librecad.rc
+    # peak memory use in iobench
+    LIBS += -lpsapi
     contains(DISABLE_POSTSCRIPT, false) {
         QMAKE_POST_LINK = "$$_PRO_FILE_PWD_/../../scripts/postprocess-win.bat" $$LC_VERSION
     }
@@ -103,6 +105,7 @@ INCLUDEPATH += \
     actions \
     main \
     main/console_dxf2pdf \
+    main/console_iobench \
     test \
     plugins \
     ui \
@@ -124,6 +127,7 @@ HEADERS += \
     lib/actions/rs_preview.h \
     lib/actions/rs_previewactioninterface.h \
     lib/actions/rs_snapper.h \
+    lib/actions/lc_snapcache.h \
     lib/creation/rs_creation.h \
     lib/debug/rs_debug.h \
     lib/engine/rs.h \
@@ -189,6 +193,8 @@ HEADERS += \
     lib/filters/rs_filterjww.h \
     lib/filters/rs_filterlff.h \
     lib/filters/rs_filterinterface.h \
+    lib/filters/lc_entitysink.h \
+    lib/filters/lc_filtersnapshot.h \
     lib/gui/rs_commandevent.h \
     lib/gui/rs_coordinateevent.h \
     lib/gui/rs_dialogfactory.h \
@@ -216,6 +222,13 @@ HEADERS += \
     lib/generators/lc_xmlwriterqxmlstreamwriter.h \
     actions/lc_actionfileexportmakercam.h \
     lib/engine/lc_rect.h \
+    lib/engine/lc_broadphase.h \
+    lib/engine/lc_preparedcontour.h \
+    lib/engine/lc_regionops.h \
+    lib/engine/lc_polylineoffset.h \
+    lib/engine/lc_pointbuffer.h \
+    lib/engine/lc_parallel.h \
+    lib/engine/lc_entityiterator.h \
     lib/engine/lc_undosection.h \
     lib/printing/lc_printing.h \
     actions/lc_actiondrawlinepolygon3.h \
@@ -226,6 +239,7 @@ SOURCES += \
     lib/actions/rs_preview.cpp \
     lib/actions/rs_previewactioninterface.cpp \
     lib/actions/rs_snapper.cpp \
+    lib/actions/lc_snapcache.cpp \
     lib/creation/rs_creation.cpp \
     lib/debug/rs_debug.cpp \
     lib/engine/rs_arc.cpp \
@@ -280,6 +294,7 @@ SOURCES += \
     lib/filters/rs_filterdxf1.cpp \
     lib/filters/rs_filterjww.cpp \
     lib/filters/rs_filterlff.cpp \
+    lib/filters/lc_filtersnapshot.cpp \
     lib/gui/rs_dialogfactory.cpp \
     lib/gui/rs_eventhandler.cpp \
     lib/gui/rs_graphicview.cpp \
@@ -306,6 +321,13 @@ SOURCES += \
     lib/engine/rs_undocycle.cpp \
     lib/engine/rs_flags.cpp \
     lib/engine/lc_rect.cpp \
+    lib/engine/lc_broadphase.cpp \
+    lib/engine/lc_preparedcontour.cpp \
+    lib/engine/lc_regionops.cpp \
+    lib/engine/lc_polylineoffset.cpp \
+    lib/engine/lc_pointbuffer.cpp \
+    lib/engine/lc_parallel.cpp \
+    lib/engine/lc_entityiterator.cpp \
     lib/engine/lc_undosection.cpp \
     lib/engine/rs.cpp \
     lib/printing/lc_printing.cpp \
@@ -891,7 +913,8 @@ HEADERS += \
     main/main.h \
     main/mainwindowx.h \
     main/console_dxf2pdf/console_dxf2pdf.h \
-    main/console_dxf2pdf/pdf_print_loop.h
+    main/console_dxf2pdf/pdf_print_loop.h \
+    main/console_iobench/console_iobench.h
 
 SOURCES += \
     main/qc_applicationwindow.cpp \
@@ -904,7 +927,8 @@ SOURCES += \
     main/main.cpp \
     main/mainwindowx.cpp \
     main/console_dxf2pdf/console_dxf2pdf.cpp \
-    main/console_dxf2pdf/pdf_print_loop.cpp
+    main/console_dxf2pdf/pdf_print_loop.cpp \
+    main/console_iobench/console_iobench.cpp
 
 # If C99 emulation is needed, add the respective source files.
 contains(DEFINES, EMU_C99) {
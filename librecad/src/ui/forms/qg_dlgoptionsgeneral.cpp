@@ -179,6 +179,8 @@ void QG_DlgOptionsGeneral::init()
     // Auto save timer
     cbAutoSaveTime->setValue(RS_SETTINGS->readNumEntry("/AutoSaveTime", 5));
     cbAutoBackup->setChecked(RS_SETTINGS->readNumEntry("/AutoBackupDocument", 1));
+    cbAutoSaveBinary->setChecked(RS_SETTINGS->readNumEntry("/AutoSaveBinary", 1));
+    cbAutoSaveSnapshot->setChecked(RS_SETTINGS->readNumEntry("/AutoSaveSnapshot", 1));
     cbUseQtFileOpenDialog->setChecked(RS_SETTINGS->readNumEntry("/UseQtFileOpenDialog", 1));
     cbWheelScrollInvertH->setChecked(RS_SETTINGS->readNumEntry("/WheelScrollInvertH", 0));
     cbWheelScrollInvertV->setChecked(RS_SETTINGS->readNumEntry("/WheelScrollInvertV", 0));
@@ -279,6 +281,8 @@ void QG_DlgOptionsGeneral::ok()
             RS_Units::unitToString( RS_Units::stringToUnit( cbUnit->currentText() ), false/*untr.*/) );
         RS_SETTINGS->writeEntry("/AutoSaveTime", cbAutoSaveTime->value() );
         RS_SETTINGS->writeEntry("/AutoBackupDocument", cbAutoBackup->isChecked() ? 1 : 0);
+        RS_SETTINGS->writeEntry("/AutoSaveBinary", cbAutoSaveBinary->isChecked() ? 1 : 0);
+        RS_SETTINGS->writeEntry("/AutoSaveSnapshot", cbAutoSaveSnapshot->isChecked() ? 1 : 0);
         RS_SETTINGS->writeEntry("/UseQtFileOpenDialog", cbUseQtFileOpenDialog->isChecked() ? 1 : 0);
         RS_SETTINGS->writeEntry("/WheelScrollInvertH", cbWheelScrollInvertH->isChecked() ? 1 : 0);
         RS_SETTINGS->writeEntry("/WheelScrollInvertV", cbWheelScrollInvertV->isChecked() ? 1 : 0);
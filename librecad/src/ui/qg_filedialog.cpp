@@ -53,6 +53,8 @@ void QG_FileDialog::getType(const QString filter)
         ftype = RS2::FormatDXFRW14;
     } else if (filter == fDxfrw12) {
         ftype = RS2::FormatDXFRW12;
+    } else if (filter == fDxfrwBinary) {
+        ftype = RS2::FormatDXFRWBinary;
 #ifdef DWGSUPPORT
     } else if (filter == fDwg) {
         ftype = RS2::FormatDWG;
@@ -61,6 +63,8 @@ void QG_FileDialog::getType(const QString filter)
         ftype = RS2::FormatJWW;
     } else if (filter == fDxf1) {
         ftype = RS2::FormatDXF1;
+    } else if (filter == fSnapshot) {
+        ftype = RS2::FormatSnapshot;
     }
 }
 
@@ -89,6 +93,7 @@ QG_FileDialog::QG_FileDialog(QWidget* parent, Qt::WindowFlags f, FileType type)
     fDxfrw2000 = tr("Drawing Exchange DXF 2000 %1").arg("(*.dxf)");
     fDxfrw14 = tr("Drawing Exchange DXF R14 %1").arg("(*.dxf)");
     fDxfrw12 = tr("Drawing Exchange DXF R12 %1").arg("(*.dxf)");
+    fDxfrwBinary = tr("Drawing Exchange DXF 2007 binary %1").arg("(*.dxf)");
     fDxfrw = tr("Drawing Exchange %1").arg("(*.dxf)");
 
     fLff = tr("LFF Font %1").arg("(*.lff)");
@@ -98,6 +103,7 @@ QG_FileDialog::QG_FileDialog(QWidget* parent, Qt::WindowFlags f, FileType type)
     fCxf = tr("QCad Font %1").arg("(*.cxf)");
     fJww = tr("Jww Drawing %1").arg("(*.jww)");
     fDxf1 = tr("QCad 1.x file %1").arg("(*.dxf)");
+    fSnapshot = tr("LibreCAD snapshot %1").arg("(*.lcsnap)");
     switch(type){
     case BlockFile:
         name=tr("Block", "block file");
@@ -118,6 +124,8 @@ QString QG_FileDialog::getExtension (RS2::FormatType type) const{
         return QString(".jww");
     case RS2::FormatCXF:
         return QString(".cxf");
+    case RS2::FormatSnapshot:
+        return QString(".lcsnap");
 #ifdef DWGSUPPORT
     case RS2::FormatDWG:
         return QString(".dwg");
@@ -141,9 +149,9 @@ QString QG_FileDialog::getOpenFile(RS2::FormatType* type){
     QString fn = "";
     QStringList filters;
 #ifdef DWGSUPPORT
-    filters << fDxfrw  << fDxf1 << fDwg << fLff << fCxf << fJww;
+    filters << fDxfrw  << fDxf1 << fDwg << fLff << fCxf << fJww << fSnapshot;
 #else
-    filters << fDxfrw  << fDxf1 << fLff << fCxf << fJww;
+    filters << fDxfrw  << fDxf1 << fLff << fCxf << fJww << fSnapshot;
 #endif
 
     setWindowTitle(tr("Open %1").arg(name));
@@ -208,9 +216,9 @@ QString QG_FileDialog::getSaveFile(RS2::FormatType* type){
     QStringList filters;
 
 #ifdef JWW_WRITE_SUPPORT
-    filters << fDxfrw2007 << fDxfrw2004 << fDxfrw2000 << fDxfrw14 << fDxfrw12 << fJww << fLff << fCxf;
+    filters << fDxfrw2007 << fDxfrw2004 << fDxfrw2000 << fDxfrw14 << fDxfrw12 << fDxfrwBinary << fJww << fLff << fCxf;
 #else
-    filters << fDxfrw2007 << fDxfrw2004 << fDxfrw2000 << fDxfrw14 << fDxfrw12 << fLff << fCxf;
+    filters << fDxfrw2007 << fDxfrw2004 << fDxfrw2000 << fDxfrw14 << fDxfrw12 << fDxfrwBinary << fLff << fCxf;
 #endif
 
     ftype = RS2::FormatDXFRW;
@@ -302,6 +310,7 @@ QString QG_FileDialog::getSaveFileName(QWidget* parent, RS2::FormatType* type) {
     filters.append("Drawing Exchange DXF 2000 (*.dxf)");
     filters.append("Drawing Exchange DXF R14 (*.dxf)");
     filters.append("Drawing Exchange DXF R12 (*.dxf)");
+    filters.append("Drawing Exchange DXF 2007 binary (*.dxf)");
     filters.append("LFF Font (*.lff)");
     filters.append("Font (*.cxf)");
     filters.append("JWW (*.jww)");
@@ -351,6 +360,8 @@ QString QG_FileDialog::getSaveFileName(QWidget* parent, RS2::FormatType* type) {
                     *type = RS2::FormatDXFRW14;
                 } else if (fileDlg->selectedNameFilter()=="Drawing Exchange DXF R12 (*.dxf)") {
                     *type = RS2::FormatDXFRW12;
+                } else if (fileDlg->selectedNameFilter()=="Drawing Exchange DXF 2007 binary (*.dxf)") {
+                    *type = RS2::FormatDXFRWBinary;
                 } else if (fileDlg->selectedNameFilter()=="JWW (*.jww)") {
                     *type = RS2::FormatJWW;
                 } else {
@@ -61,6 +61,7 @@ private:
     QString fDxfrw2000;
     QString fDxfrw14;
     QString fDxfrw12;
+    QString fDxfrwBinary;
     QString fDxfrw;
 #ifdef DWGSUPPORT
     QString fDwg;
@@ -69,6 +70,7 @@ private:
     QString fLff;
     QString fCxf;
     QString fJww;
+    QString fSnapshot;
     QString name;
 
 };